@@ -51,6 +51,11 @@ parser.add_argument(
     "components",
     help="components of a compound flag, if applicable, joined with :",
 )
+parser.add_argument(
+    "--pruned",
+    action="store_true",
+    help="compile the flag out of non-debug builds",
+)
 
 args = parser.parse_args()
 
@@ -63,6 +68,9 @@ else:
     print(f'Unrecognized "FMT" value {fmt}', file=sys.stderr)
     sys.exit(1)
 components = args.components.split(":") if args.components else []
+if components and args.pruned:
+    print(f"Compound flag {args.name} cannot be pruned", file=sys.stderr)
+    sys.exit(1)
 
 code = code_formatter()
 
@@ -103,7 +111,8 @@ inline union ${{args.name}}
     CompoundFlag ${{args.name}} = {
         "${{args.name}}", "${{args.desc}}", {
             ${{",\\n            ".join(
-                f"(Flag *)&::gem5::debug::{flag}" for flag in components)}}
+                f"(Flag *)&::gem5::debug::unions::{flag}.{flag}"
+                for flag in components)}}
         }
     };
 } ${{args.name}};
@@ -125,10 +134,38 @@ inline union ${{args.name}}
 code(
     """
 } // namespace unions
+"""
+)
+
+# A pruned flag still exists, so it can be listed and be part of compound
+# flags, but the DPRINTFs using it see a flag that is always off and are
+# optimized away together with their arguments.
+if args.pruned:
+    code(
+        """
 
+#ifdef GEM5_DEBUG
 inline constexpr const auto& ${{args.name}} =
     ::gem5::debug::unions::${{args.name}}.${{args.name}};
+#else
+inline constexpr PrunedFlag ${{args.name}} =
+    ::gem5::debug::unions::${{args.name}}.${{args.name}};
+#endif
 
+"""
+    )
+else:
+    code(
+        """
+
+inline constexpr const auto& ${{args.name}} =
+    ::gem5::debug::unions::${{args.name}}.${{args.name}};
+
+"""
+    )
+
+code(
+    """
 } // namespace debug
 } // namespace gem5
 
@@ -787,6 +787,7 @@ def makeDistRoot(
     linkspeed,
     linkdelay,
     dumpfile,
+    transport="tcp",
 ):
     self = Root(full_system=True)
     self.testsys = testSystem
@@ -800,6 +801,7 @@ def makeDistRoot(
         server_port=server_port,
         sync_start=sync_start,
         sync_repeat=sync_repeat,
+        transport=transport,
     )
 
     if hasattr(testSystem, "realview"):
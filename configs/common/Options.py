@@ -424,6 +424,13 @@ def addCommonOptions(parser, default_isa: Optional[ISA] = None):
         type=int,
         help="Message server listen port\nDEFAULT: 2200",
     )
+    parser.add_argument(
+        "--dist-transport",
+        default="tcp",
+        choices=["tcp", "shm"],
+        help="Connection among dist-gem5 processes, shm (shared memory) "
+        "if they all run on this host\nDEFAULT: tcp",
+    )
     parser.add_argument(
         "--dist-sync-repeat",
         default="0us",
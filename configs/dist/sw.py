@@ -58,6 +58,7 @@ def build_switch(args):
             sync_repeat=args.dist_sync_repeat,
             is_switch=True,
             num_nodes=args.dist_size,
+            transport=args.dist_transport,
         )
         for i in range(args.dist_size)
     ]
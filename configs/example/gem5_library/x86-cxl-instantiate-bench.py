@@ -0,0 +1,103 @@
+"""
+Measures how long it takes to configure and instantiate a large CXL-DMSim
+system, without simulating it. Use it to keep an eye on the start-up time
+of big parameter sweeps: the time is reported for building the Python
+configuration and for m5.instantiate(), which creates the C++ objects,
+connects their ports and initializes them.
+
+The kernel and disk image are only needed because the workload loads the
+kernel when it is created, nothing is booted.
+
+Usage
+-----
+
+```
+scons build/X86/gem5.opt -j16
+build/X86/gem5.opt configs/example/gem5_library/x86-cxl-instantiate-bench.py \\
+    --kernel <vmlinux> --disk <image> --num_cpus 64
+```
+"""
+
+import argparse
+import time
+
+from gem5.components.boards.x86_board import X86Board
+from gem5.components.cachehierarchies.classic.private_l1_private_l2_shared_l3_cache_hierarchy import (
+    PrivateL1PrivateL2SharedL3CacheHierarchy,
+)
+from gem5.components.memory.single_channel import DIMM_DDR5_4400
+from gem5.components.processors.cpu_types import CPUTypes
+from gem5.components.processors.simple_processor import SimpleProcessor
+from gem5.isas import ISA
+from gem5.resources.resource import (
+    DiskImageResource,
+    KernelResource,
+)
+from gem5.simulate.simulator import Simulator
+from gem5.utils.requires import requires
+
+requires(isa_required=ISA.X86)
+
+parser = argparse.ArgumentParser(
+    description="Times the configuration of a large CXL system."
+)
+parser.add_argument("--kernel", required=True, help="Path to the kernel")
+parser.add_argument("--disk", required=True, help="Path to the disk image")
+parser.add_argument("--num_cpus", type=int, default=64, help="Number of CPUs")
+parser.add_argument(
+    "--cpu_type",
+    type=str,
+    choices=["TIMING", "O3"],
+    default="O3",
+    help="CPU type",
+)
+
+args = parser.parse_args()
+
+start = time.perf_counter()
+
+cache_hierarchy = PrivateL1PrivateL2SharedL3CacheHierarchy(
+    l1d_size="48kB",
+    l1d_assoc=6,
+    l1i_size="32kB",
+    l1i_assoc=8,
+    l2_size="2MB",
+    l2_assoc=16,
+    l3_size="96MB",
+    l3_assoc=48,
+)
+
+processor = SimpleProcessor(
+    cpu_type=CPUTypes.O3 if args.cpu_type == "O3" else CPUTypes.TIMING,
+    isa=ISA.X86,
+    num_cores=args.num_cpus,
+)
+
+board = X86Board(
+    clk_freq="2.4GHz",
+    processor=processor,
+    memory=DIMM_DDR5_4400(size="3GB"),
+    cache_hierarchy=cache_hierarchy,
+    cxl_memory=DIMM_DDR5_4400(size="8GB"),
+    is_asic=True,
+)
+
+board.set_kernel_disk_workload(
+    kernel=KernelResource(local_path=args.kernel),
+    disk_image=DiskImageResource(local_path=args.disk),
+)
+
+simulator = Simulator(board=board)
+
+configured = time.perf_counter()
+simulator._instantiate()
+instantiated = time.perf_counter()
+
+num_objects = sum(1 for _ in simulator._root.descendants())
+instantiate_secs = instantiated - configured
+print(f"SimObjects:     {num_objects}")
+print(f"Configuration:  {configured - start:.2f} s")
+print(
+    f"Instantiation:  {instantiate_secs:.2f} s, "
+    f"{instantiate_secs / num_objects * 1e6:.0f} us per SimObject"
+)
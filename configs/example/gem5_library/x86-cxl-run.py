@@ -111,6 +111,14 @@ parser.add_argument(
     default="DRAM",
     help="CXL memory type",
 )
+parser.add_argument(
+    "--cxl_backend",
+    type=str,
+    choices=["gem5", "DRAMsim3", "DRAMSys"],
+    default="gem5",
+    help="Model of the CXL memory media. DRAMsim3 and DRAMSys need gem5 "
+    "to be built with them, see ext/dramsim3 and ext/dramsys.",
+)
 
 args = parser.parse_args()
 
@@ -128,7 +136,15 @@ cache_hierarchy = PrivateL1PrivateL2SharedL3CacheHierarchy(
 
 # Setup the system memory.
 memory = DIMM_DDR5_4400(size="3GB")
-if args.is_asic:
+if args.cxl_backend == "DRAMsim3":
+    from gem5.components.memory.dramsim_3 import SingleChannel
+
+    cxl_memory = SingleChannel("DDR4_8Gb_x8_3200", size="8GB")
+elif args.cxl_backend == "DRAMSys":
+    from gem5.components.memory.dramsys import DRAMSysDDR4_1866
+
+    cxl_memory = DRAMSysDDR4_1866(recordable=False)
+elif args.is_asic:
     cxl_memory = DIMM_DDR5_4400(size="8GB")
 else:
     cxl_memory = SingleChannelDDR4_3200(size="8GB")
@@ -0,0 +1,168 @@
+"""
+Sweeps the latencies of the CXL path from a single booted system. Ubuntu is
+booted once with KVM cores, which are then switched to TIMING cores. At the
+second `m5 exit` of the guest the simulation is forked, once per point of
+the sweep: each child changes the protocol processing latencies of the
+CXLBridge and of the CXLMemory device and runs the benchmark until the
+third `m5 exit`.
+
+The simulated time and the queue statistics of every point are written to
+`m5out/sweep.csv`, the output of each child is in `m5out/sweep<N>`.
+
+Usage
+-----
+
+```
+scons build/X86/gem5.opt -j16
+build/X86/gem5.opt configs/example/gem5_library/x86-cxl-sweep.py \\
+    --kernel <vmlinux> --disk <image> \\
+    --bridge_lats 12ns 24ns --device_lats 15ns 30ns 60ns
+```
+"""
+
+import argparse
+
+import m5
+
+from gem5.components.boards.x86_board import X86Board
+from gem5.components.cachehierarchies.classic.private_l1_private_l2_shared_l3_cache_hierarchy import (
+    PrivateL1PrivateL2SharedL3CacheHierarchy,
+)
+from gem5.components.memory.single_channel import DIMM_DDR5_4400
+from gem5.components.processors.cpu_types import CPUTypes
+from gem5.components.processors.simple_switchable_processor import (
+    SimpleSwitchableProcessor,
+)
+from gem5.isas import ISA
+from gem5.resources.resource import (
+    DiskImageResource,
+    KernelResource,
+)
+from gem5.simulate.exit_event import ExitEvent
+from gem5.simulate.simulator import Simulator
+from gem5.simulate.sweep import ForkSweep
+from gem5.utils.requires import requires
+
+requires(isa_required=ISA.X86, kvm_required=True)
+
+parser = argparse.ArgumentParser(
+    description="Sweeps the CXL latencies from one booted system."
+)
+parser.add_argument("--kernel", required=True, help="Path to the kernel")
+parser.add_argument("--disk", required=True, help="Path to the disk image")
+parser.add_argument(
+    "--test_cmd",
+    type=str,
+    default="lmbench_cxl.sh",
+    help="Benchmark script in /home/cxl_benchmark of the disk image",
+)
+parser.add_argument(
+    "--bridge_lats",
+    nargs="+",
+    default=["12ns"],
+    help="Protocol processing latencies of the CXLBridge",
+)
+parser.add_argument(
+    "--device_lats",
+    nargs="+",
+    default=["15ns", "30ns", "60ns"],
+    help="Protocol processing latencies of the CXLMemory device",
+)
+parser.add_argument(
+    "--max_parallel",
+    type=int,
+    default=None,
+    help="Points simulated at the same time, the host CPUs by default",
+)
+
+args = parser.parse_args()
+
+cache_hierarchy = PrivateL1PrivateL2SharedL3CacheHierarchy(
+    l1d_size="48kB",
+    l1d_assoc=6,
+    l1i_size="32kB",
+    l1i_assoc=8,
+    l2_size="2MB",
+    l2_assoc=16,
+    l3_size="96MB",
+    l3_assoc=48,
+)
+
+processor = SimpleSwitchableProcessor(
+    starting_core_type=CPUTypes.KVM,
+    switch_core_type=CPUTypes.TIMING,
+    isa=ISA.X86,
+    num_cores=1,
+)
+
+for proc in processor.start:
+    proc.core.usePerf = False
+
+board = X86Board(
+    clk_freq="2.4GHz",
+    processor=processor,
+    memory=DIMM_DDR5_4400(size="3GB"),
+    cache_hierarchy=cache_hierarchy,
+    cxl_memory=DIMM_DDR5_4400(size="8GB"),
+    is_asic=True,
+)
+
+command = (
+    "m5 exit;"
+    + "m5 exit;"
+    + "/home/cxl_benchmark/"
+    + args.test_cmd
+    + ";"
+    + "m5 exit;"
+)
+
+board.set_kernel_disk_workload(
+    kernel=KernelResource(local_path=args.kernel),
+    disk_image=DiskImageResource(local_path=args.disk),
+    readfile_contents=command,
+)
+
+
+def on_exit():
+    # Booted, continue on the TIMING cores up to the start of the sweep
+    processor.switch()
+    yield False
+    # The state the points are forked from
+    yield True
+    # The benchmark of a point is done
+    yield True
+
+
+simulator = Simulator(
+    board=board,
+    on_exit_event={ExitEvent.EXIT: on_exit()},
+)
+
+# Forking needs the listeners, e.g., the GDB ports, to be disabled before
+# the simulator is instantiated
+m5.disableAllListeners()
+simulator.run()
+
+
+def apply(point):
+    board.bridge.setLatencies("50ns", point["bridge_lat"])
+    board.pc.south_bridge.cxlmemory.setProtoProcLat(point["device_lat"])
+
+
+sweep = ForkSweep(
+    simulator,
+    points=ForkSweep.grid(
+        bridge_lat=args.bridge_lats, device_lat=args.device_lats
+    ),
+    apply=apply,
+    stats=[
+        "simSeconds",
+        "board.bridge.reqQueFullEvents",
+        "board.pc.south_bridge.cxlmemory.reqQueFullEvents",
+        "board.pc.south_bridge.cxlmemory.rspQueFullEvents",
+    ],
+    max_parallel=args.max_parallel,
+)
+
+for row in sweep.run():
+    print(row)
@@ -527,11 +527,12 @@ namespace X86ISA
                         } else {
                             Addr alignedVaddr = p->pTable->pageAlign(vaddr);
 
+                            Addr pagePaddr = pte->translate(alignedVaddr);
                             DPRINTF(GPUTLB, "Mapping %#x to %#x\n",
-                                    alignedVaddr, pte->paddr);
+                                    alignedVaddr, pagePaddr);
 
                             TlbEntry gpuEntry(p->pid(), alignedVaddr,
-                                              pte->paddr, false, false);
+                                              pagePaddr, false, false);
                             entry = insert(alignedVaddr, gpuEntry);
                         }
 
@@ -963,11 +964,12 @@ namespace X86ISA
             }
 
             if (pte) {
+                Addr pagePaddr = pte->translate(alignedVaddr);
                 DPRINTF(GPUTLB, "Mapping %#x to %#x\n", alignedVaddr,
-                        pte->paddr);
+                        pagePaddr);
 
                 sender_state->tlbEntry =
-                    new TlbEntry(p->pid(), virtPageAddr, pte->paddr, false,
+                    new TlbEntry(p->pid(), virtPageAddr, pagePaddr, false,
                                  false);
             } else {
                 sender_state->tlbEntry = nullptr;
@@ -1172,24 +1174,26 @@ namespace X86ISA
                     // the second page table lookup
                     assert(pte);
 
+                    Addr pagePaddr = pte->translate(alignedVaddr);
                     DPRINTF(GPUTLB, "Mapping %#x to %#x\n", alignedVaddr,
-                            pte->paddr);
+                            pagePaddr);
 
                     sender_state->tlbEntry =
                         new TlbEntry(p->pid(), virt_page_addr,
-                                     pte->paddr, false, false);
+                                     pagePaddr, false, false);
                 } else {
                     // If this was a prefetch, then do the normal thing if it
                     // was a successful translation.  Otherwise, send an empty
                     // TLB entry back so that it can be figured out as empty
                     // and handled accordingly.
                     if (pte) {
+                        Addr pagePaddr = pte->translate(alignedVaddr);
                         DPRINTF(GPUTLB, "Mapping %#x to %#x\n", alignedVaddr,
-                                pte->paddr);
+                                pagePaddr);
 
                         sender_state->tlbEntry =
                             new TlbEntry(p->pid(), virt_page_addr,
-                                         pte->paddr, false, false);
+                                         pagePaddr, false, false);
                     } else {
                         DPRINTF(GPUPrefetch, "Prefetch failed %#x\n",
                                 alignedVaddr);
@@ -738,9 +738,9 @@ class SyscallTable64 : public SyscallDescTable<EmuLinux::SyscallABI64>
         {  base + 232, "mincore" },
         {  base + 233, "madvise", ignoreFunc },
         {  base + 234, "remap_file_pages" },
-        {  base + 235, "mbind" },
-        {  base + 236, "get_mempolicy" },
-        {  base + 237, "set_mempolicy" },
+        {  base + 235, "mbind", mbindFunc },
+        {  base + 236, "get_mempolicy", getMempolicyFunc },
+        {  base + 237, "set_mempolicy", setMempolicyFunc },
         {  base + 238, "migrate_pages" },
         {  base + 239, "move_pages" },
         {  base + 240, "rt_tgsigqueueinfo" },
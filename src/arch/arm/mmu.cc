@@ -267,7 +267,7 @@ MMU::translateSe(const RequestPtr &req, ThreadContext *tc, Mode mode,
     if (const auto pte = p->pTable->lookup(vaddr); !pte) {
         return std::make_shared<GenericPageTableFault>(vaddr_tainted);
     } else {
-        req->setPaddr(pte->paddr + p->pTable->pageOffset(vaddr));
+        req->setPaddr(pte->translate(vaddr));
 
         if (pte->flags & EmulationPageTable::Uncacheable)
             req->setFlags(Request::UNCACHEABLE);
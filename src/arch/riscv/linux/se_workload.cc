@@ -362,9 +362,9 @@ SyscallDescTable<SEWorkload::SyscallABI64> EmuLinux::syscallDescs64 = {
     { 232,  "mincore", ignoreFunc },
     { 233,  "madvise", ignoreFunc },
     { 234,  "remap_file_pages" },
-    { 235,  "mbind", ignoreFunc },
-    { 236,  "get_mempolicy" },
-    { 237,  "set_mempolicy" },
+    { 235,  "mbind", mbindFunc },
+    { 236,  "get_mempolicy", getMempolicyFunc },
+    { 237,  "set_mempolicy", setMempolicyFunc },
     { 238,  "migrate_pages" },
     { 239,  "move_pages" },
     { 240,  "tgsigqueueinfo" },
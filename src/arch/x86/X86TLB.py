@@ -57,6 +57,11 @@ class X86TLB(BaseTLB):
     cxx_header = "arch/x86/tlb.hh"
 
     size = Param.Unsigned(128, "TLB size")
+    micro_size = Param.Unsigned(
+        16,
+        "Number of recent translations cached in front of the TLB lookup "
+        "structure (power of 2, 0 to disable). Does not affect timing.",
+    )
     system = Param.System(Parent.any, "system object")
     walker = Param.X86PagetableWalker(
         X86PagetableWalker(), "page table walker"
@@ -152,3 +152,114 @@ class X86ACPIRSDP(SimObject):
     xsdt = Param.X86ACPIXSDT(
         X86ACPIXSDT(), "extended system description table"
     )
+
+
+class X86ACPISratRecord(SimObject):
+    type = "X86ACPISratRecord"
+    cxx_class = "gem5::X86ISA::ACPI::SRAT::Record"
+    cxx_header = "arch/x86/bios/acpi.hh"
+    abstract = True
+
+
+# System Resource Affinity Table, which assigns processors and memory ranges
+# to NUMA proximity domains.
+class X86ACPISrat(X86ACPISysDescTable):
+    type = "X86ACPISrat"
+    cxx_class = "gem5::X86ISA::ACPI::SRAT::SRAT"
+    cxx_header = "arch/x86/bios/acpi.hh"
+
+    records = VectorParam.X86ACPISratRecord([], "Records in this SRAT")
+
+
+class X86ACPISratLAPIC(X86ACPISratRecord):
+    type = "X86ACPISratLAPIC"
+    cxx_header = "arch/x86/bios/acpi.hh"
+    cxx_class = "gem5::X86ISA::ACPI::SRAT::LAPIC"
+
+    proximity_domain = Param.UInt32(0, "Proximity domain of the processor")
+    apic_id = Param.UInt8(0, "APIC ID")
+    flags = Param.UInt32(1, "Flags (bit 0: enabled)")
+
+
+class X86ACPISratMemory(X86ACPISratRecord):
+    type = "X86ACPISratMemory"
+    cxx_header = "arch/x86/bios/acpi.hh"
+    cxx_class = "gem5::X86ISA::ACPI::SRAT::Memory"
+
+    proximity_domain = Param.UInt32(0, "Proximity domain of the memory")
+    range = Param.AddrRange("Physical address range of the memory")
+    flags = Param.UInt32(
+        1, "Flags (bit 0: enabled, bit 1: hot pluggable, bit 2: non-volatile)"
+    )
+
+
+# System Locality Information Table, the relative distances between
+# proximity domains. 10 is the distance of a domain to itself.
+class X86ACPISlit(X86ACPISysDescTable):
+    type = "X86ACPISlit"
+    cxx_class = "gem5::X86ISA::ACPI::SLIT"
+    cxx_header = "arch/x86/bios/acpi.hh"
+
+    distances = VectorParam.UInt8(
+        [], "Distance matrix in row-major order, one row per initiator"
+    )
+
+
+class X86ACPIHmatRecord(SimObject):
+    type = "X86ACPIHmatRecord"
+    cxx_class = "gem5::X86ISA::ACPI::HMAT::Record"
+    cxx_header = "arch/x86/bios/acpi.hh"
+    abstract = True
+
+
+# Heterogeneous Memory Attribute Table, the latency and bandwidth between
+# initiator and memory proximity domains.
+class X86ACPIHmat(X86ACPISysDescTable):
+    type = "X86ACPIHmat"
+    cxx_class = "gem5::X86ISA::ACPI::HMAT::HMAT"
+    cxx_header = "arch/x86/bios/acpi.hh"
+
+    records = VectorParam.X86ACPIHmatRecord([], "Records in this HMAT")
+
+
+class X86ACPIHmatProximityDomain(X86ACPIHmatRecord):
+    type = "X86ACPIHmatProximityDomain"
+    cxx_header = "arch/x86/bios/acpi.hh"
+    cxx_class = "gem5::X86ISA::ACPI::HMAT::ProximityDomain"
+
+    initiator = Param.Int32(
+        -1, "Proximity domain of the initiator attached to the memory, "
+        "-1 if none"
+    )
+    memory = Param.UInt32(0, "Proximity domain of the memory")
+
+
+class X86ACPIHmatDataType(Enum):
+    map = {
+        "AccessLatency": 0,
+        "ReadLatency": 1,
+        "WriteLatency": 2,
+        "AccessBandwidth": 3,
+        "ReadBandwidth": 4,
+        "WriteBandwidth": 5,
+    }
+
+
+class X86ACPIHmatLocality(X86ACPIHmatRecord):
+    type = "X86ACPIHmatLocality"
+    cxx_header = "arch/x86/bios/acpi.hh"
+    cxx_class = "gem5::X86ISA::ACPI::HMAT::Locality"
+
+    data_type = Param.X86ACPIHmatDataType(
+        "AccessLatency", "Type of the entries"
+    )
+    initiators = VectorParam.UInt32([], "Initiator proximity domains")
+    targets = VectorParam.UInt32([], "Target proximity domains")
+    base_unit = Param.UInt64(
+        1000,
+        "Multiplier of the entries, in picoseconds for latencies and "
+        "MB/s for bandwidths",
+    )
+    entries = VectorParam.UInt16(
+        [], "Entries in row-major order, one row per initiator"
+    )
@@ -41,6 +41,7 @@
 #include <cassert>
 #include <cstring>
 
+#include "base/bitfield.hh"
 #include "base/trace.hh"
 #include "mem/port.hh"
 #include "mem/port_proxy.hh"
@@ -331,6 +332,209 @@ MADT::LAPICOverride::prepareBuf(std::vector<uint8_t>& mem) const
     Record::prepareBuf(mem);
 }
 
+//// SRAT
+SRAT::SRAT::SRAT(const Params& p) :
+    SysDescTable(p, "SRAT", 3),
+    records(p.records)
+{}
+
+Addr
+SRAT::SRAT::writeBuf(PortProxy& phys_proxy, Allocator& alloc,
+        std::vector<uint8_t>& mem) const
+{
+    // Since this table ends with a variably sized array, it can't be extended
+    // by another table type.
+    assert(mem.empty());
+    mem.resize(sizeof(Mem));
+
+    // The reserved fields have fixed values.
+    *reinterpret_cast<Mem*>(mem.data()) = Mem();
+
+    for (const auto& record : records) {
+        auto entry = record->prepare();
+        mem.insert(mem.end(), entry.begin(), entry.end());
+    }
+
+    DPRINTF(ACPI, "SRAT: writing %d records (size: %d)\n",
+            records.size(), mem.size());
+
+    return SysDescTable::writeBuf(phys_proxy, alloc, mem);
+}
+
+void
+SRAT::Record::prepareBuf(std::vector<uint8_t>& mem) const
+{
+    assert(mem.size() >= sizeof(Mem));
+    DPRINTF(ACPI, "SRAT: writing record type %d (size: %d)\n",
+            type, mem.size());
+
+    Mem* header = reinterpret_cast<Mem*>(mem.data());
+    header->type = type;
+    header->length = mem.size();
+}
+
+void
+SRAT::LAPIC::prepareBuf(std::vector<uint8_t>& mem) const
+{
+    assert(mem.empty());
+    mem.resize(sizeof(Mem));
+
+    Mem* data = reinterpret_cast<Mem*>(mem.data());
+    uint32_t domain = params().proximity_domain;
+    data->proximityDomainLo = bits(domain, 7, 0);
+    data->proximityDomainHi[0] = bits(domain, 15, 8);
+    data->proximityDomainHi[1] = bits(domain, 23, 16);
+    data->proximityDomainHi[2] = bits(domain, 31, 24);
+    data->apicId = params().apic_id;
+    data->flags = params().flags;
+
+    Record::prepareBuf(mem);
+}
+
+void
+SRAT::Memory::prepareBuf(std::vector<uint8_t>& mem) const
+{
+    assert(mem.empty());
+    mem.resize(sizeof(Mem));
+
+    Mem* data = reinterpret_cast<Mem*>(mem.data());
+    data->proximityDomain = params().proximity_domain;
+    data->baseAddress = params().range.start();
+    data->length = params().range.size();
+    data->flags = params().flags;
+
+    Record::prepareBuf(mem);
+}
+
+
+//// SLIT
+SLIT::SLIT(const Params& p) :
+    SysDescTable(p, "SLIT", 1),
+    numLocalities(0)
+{
+    while (numLocalities * numLocalities < p.distances.size())
+        numLocalities++;
+    fatal_if(numLocalities * numLocalities != p.distances.size(),
+            "SLIT: the distance matrix (%d entries) is not square.",
+            p.distances.size());
+}
+
+Addr
+SLIT::writeBuf(PortProxy& phys_proxy, Allocator& alloc,
+        std::vector<uint8_t>& mem) const
+{
+    // Since this table ends with a variably sized array, it can't be extended
+    // by another table type.
+    assert(mem.empty());
+    mem.resize(sizeof(Mem));
+
+    Mem* header = reinterpret_cast<Mem*>(mem.data());
+    header->numLocalities = numLocalities;
+
+    const auto &distances = params().distances;
+    mem.insert(mem.end(), distances.begin(), distances.end());
+
+    DPRINTF(ACPI, "SLIT: writing %d localities (size: %d)\n",
+            numLocalities, mem.size());
+
+    return SysDescTable::writeBuf(phys_proxy, alloc, mem);
+}
+
+
+//// HMAT
+HMAT::HMAT::HMAT(const Params& p) :
+    SysDescTable(p, "HMAT", 2),
+    records(p.records)
+{}
+
+Addr
+HMAT::HMAT::writeBuf(PortProxy& phys_proxy, Allocator& alloc,
+        std::vector<uint8_t>& mem) const
+{
+    // Since this table ends with a variably sized array, it can't be extended
+    // by another table type.
+    assert(mem.empty());
+    mem.resize(sizeof(Mem));
+
+    for (const auto& record : records) {
+        auto entry = record->prepare();
+        mem.insert(mem.end(), entry.begin(), entry.end());
+    }
+
+    DPRINTF(ACPI, "HMAT: writing %d records (size: %d)\n",
+            records.size(), mem.size());
+
+    return SysDescTable::writeBuf(phys_proxy, alloc, mem);
+}
+
+void
+HMAT::Record::prepareBuf(std::vector<uint8_t>& mem) const
+{
+    assert(mem.size() >= sizeof(Mem));
+    DPRINTF(ACPI, "HMAT: writing record type %d (size: %d)\n",
+            type, mem.size());
+
+    Mem* header = reinterpret_cast<Mem*>(mem.data());
+    header->type = type;
+    header->length = mem.size();
+}
+
+void
+HMAT::ProximityDomain::prepareBuf(std::vector<uint8_t>& mem) const
+{
+    assert(mem.empty());
+    mem.resize(sizeof(Mem));
+
+    Mem* data = reinterpret_cast<Mem*>(mem.data());
+    if (params().initiator >= 0) {
+        // The initiator proximity domain field is valid.
+        data->flags = 1;
+        data->initiatorProximityDomain = params().initiator;
+    }
+    data->memoryProximityDomain = params().memory;
+
+    Record::prepareBuf(mem);
+}
+
+HMAT::Locality::Locality(const Params& p) : Record(p, 1)
+{
+    fatal_if(p.entries.size() != p.initiators.size() * p.targets.size(),
+            "HMAT: expected %d x %d locality entries, got %d.",
+            p.initiators.size(), p.targets.size(), p.entries.size());
+}
+
+void
+HMAT::Locality::prepareBuf(std::vector<uint8_t>& mem) const
+{
+    assert(mem.empty());
+    const auto &p = params();
+    mem.resize(sizeof(Mem) +
+            sizeof(uint32_t) * (p.initiators.size() + p.targets.size()) +
+            sizeof(uint16_t) * p.entries.size());
+
+    Mem* data = reinterpret_cast<Mem*>(mem.data());
+    // Memory hierarchy: the memory itself, not a memory side cache.
+    data->flags = 0;
+    data->dataType = p.data_type;
+    data->numInitiators = p.initiators.size();
+    data->numTargets = p.targets.size();
+    data->entryBaseUnit = p.base_unit;
+
+    uint8_t *pos = mem.data() + sizeof(Mem);
+    auto append = [&pos](const auto &vals) {
+        for (auto val : vals) {
+            std::memcpy(pos, &val, sizeof(val));
+            pos += sizeof(val);
+        }
+    };
+    append(p.initiators);
+    append(p.targets);
+    append(p.entries);
+    assert(pos == mem.data() + mem.size());
+
+    Record::prepareBuf(mem);
+}
+
 } // namespace ACPI
 
 } // namespace X86ISA
@@ -46,6 +46,11 @@
 #include "base/compiler.hh"
 #include "base/types.hh"
 #include "debug/ACPI.hh"
+#include "enums/X86ACPIHmatDataType.hh"
+#include "params/X86ACPIHmat.hh"
+#include "params/X86ACPIHmatLocality.hh"
+#include "params/X86ACPIHmatProximityDomain.hh"
+#include "params/X86ACPIHmatRecord.hh"
 #include "params/X86ACPIMadt.hh"
 #include "params/X86ACPIMadtIOAPIC.hh"
 #include "params/X86ACPIMadtIntSourceOverride.hh"
@@ -55,6 +60,11 @@
 #include "params/X86ACPIMadtRecord.hh"
 #include "params/X86ACPIRSDP.hh"
 #include "params/X86ACPIRSDT.hh"
+#include "params/X86ACPISlit.hh"
+#include "params/X86ACPISrat.hh"
+#include "params/X86ACPISratLAPIC.hh"
+#include "params/X86ACPISratMemory.hh"
+#include "params/X86ACPISratRecord.hh"
 #include "params/X86ACPISysDescTable.hh"
 #include "params/X86ACPIXSDT.hh"
 #include "sim/sim_object.hh"
@@ -359,6 +369,239 @@ class MADT : public SysDescTable
 
 } // namespace MADT
 
+namespace SRAT
+{
+class Record : public SimObject
+{
+  protected:
+    PARAMS(X86ACPISratRecord);
+
+    struct GEM5_PACKED Mem
+    {
+        uint8_t type = 0;
+        uint8_t length = 0;
+    };
+    static_assert(std::is_trivially_copyable_v<Mem>,
+            "Type not suitable for memcpy.");
+
+    uint8_t type;
+
+    virtual void prepareBuf(std::vector<uint8_t>& mem) const = 0;
+
+  public:
+    Record(const Params& p, uint8_t _type) : SimObject(p), type(_type) {}
+
+    std::vector<uint8_t>
+    prepare() const
+    {
+        std::vector<uint8_t> mem;
+        prepareBuf(mem);
+        return mem;
+    }
+};
+
+class LAPIC : public Record
+{
+  protected:
+    PARAMS(X86ACPISratLAPIC);
+
+    struct GEM5_PACKED Mem : public Record::Mem
+    {
+        uint8_t proximityDomainLo = 0;
+        uint8_t apicId = 0;
+        uint32_t flags = 0;
+        uint8_t localSapicEid = 0;
+        uint8_t proximityDomainHi[3] = {};
+        uint32_t clockDomain = 0;
+    };
+    static_assert(std::is_trivially_copyable_v<Mem>,
+            "Type not suitable for memcpy.");
+    static_assert(sizeof(Mem) == 16, "Wrong SRAT LAPIC record size.");
+
+    void prepareBuf(std::vector<uint8_t>& mem) const override;
+
+  public:
+    LAPIC(const Params& p) : Record(p, 0) {}
+};
+
+class Memory : public Record
+{
+  protected:
+    PARAMS(X86ACPISratMemory);
+
+    struct GEM5_PACKED Mem : public Record::Mem
+    {
+        uint32_t proximityDomain = 0;
+        uint16_t _reserved1 = 0;
+        uint64_t baseAddress = 0;
+        uint64_t length = 0;
+        uint32_t _reserved2 = 0;
+        uint32_t flags = 0;
+        uint64_t _reserved3 = 0;
+    };
+    static_assert(std::is_trivially_copyable_v<Mem>,
+            "Type not suitable for memcpy.");
+    static_assert(sizeof(Mem) == 40, "Wrong SRAT memory record size.");
+
+    void prepareBuf(std::vector<uint8_t>& mem) const override;
+
+  public:
+    Memory(const Params& p) : Record(p, 1) {}
+};
+
+class SRAT : public SysDescTable
+{
+  protected:
+    PARAMS(X86ACPISrat);
+
+    struct GEM5_PACKED Mem : public SysDescTable::Mem
+    {
+        // Must be 1 for backward compatibility
+        uint32_t _reserved1 = 1;
+        uint64_t _reserved2 = 0;
+    };
+    static_assert(std::is_trivially_copyable_v<Mem>,
+            "Type not suitable for memcpy.");
+
+    std::vector<Record *> records;
+
+    Addr writeBuf(PortProxy& phys_proxy, Allocator& alloc,
+            std::vector<uint8_t>& mem) const override;
+
+  public:
+    SRAT(const Params &p);
+};
+
+} // namespace SRAT
+
+class SLIT : public SysDescTable
+{
+  protected:
+    PARAMS(X86ACPISlit);
+
+    struct GEM5_PACKED Mem : public SysDescTable::Mem
+    {
+        uint64_t numLocalities = 0;
+    };
+    static_assert(std::is_trivially_copyable_v<Mem>,
+            "Type not suitable for memcpy.");
+
+    uint64_t numLocalities;
+
+    Addr writeBuf(PortProxy& phys_proxy, Allocator& alloc,
+            std::vector<uint8_t>& mem) const override;
+
+  public:
+    SLIT(const Params &p);
+};
+
+namespace HMAT
+{
+class Record : public SimObject
+{
+  protected:
+    PARAMS(X86ACPIHmatRecord);
+
+    struct GEM5_PACKED Mem
+    {
+        uint16_t type = 0;
+        uint16_t _reserved = 0;
+        uint32_t length = 0;
+    };
+    static_assert(std::is_trivially_copyable_v<Mem>,
+            "Type not suitable for memcpy.");
+
+    uint16_t type;
+
+    virtual void prepareBuf(std::vector<uint8_t>& mem) const = 0;
+
+  public:
+    Record(const Params& p, uint16_t _type) : SimObject(p), type(_type) {}
+
+    std::vector<uint8_t>
+    prepare() const
+    {
+        std::vector<uint8_t> mem;
+        prepareBuf(mem);
+        return mem;
+    }
+};
+
+class ProximityDomain : public Record
+{
+  protected:
+    PARAMS(X86ACPIHmatProximityDomain);
+
+    struct GEM5_PACKED Mem : public Record::Mem
+    {
+        uint16_t flags = 0;
+        uint16_t _reserved1 = 0;
+        uint32_t initiatorProximityDomain = 0;
+        uint32_t memoryProximityDomain = 0;
+        uint32_t _reserved2 = 0;
+        uint64_t _reserved3 = 0;
+        uint64_t _reserved4 = 0;
+    };
+    static_assert(std::is_trivially_copyable_v<Mem>,
+            "Type not suitable for memcpy.");
+    static_assert(sizeof(Mem) == 40,
+            "Wrong HMAT proximity domain record size.");
+
+    void prepareBuf(std::vector<uint8_t>& mem) const override;
+
+  public:
+    ProximityDomain(const Params& p) : Record(p, 0) {}
+};
+
+class Locality : public Record
+{
+  protected:
+    PARAMS(X86ACPIHmatLocality);
+
+    struct GEM5_PACKED Mem : public Record::Mem
+    {
+        uint8_t flags = 0;
+        uint8_t dataType = 0;
+        uint8_t minTransferSize = 0;
+        uint8_t _reserved1 = 0;
+        uint32_t numInitiators = 0;
+        uint32_t numTargets = 0;
+        uint32_t _reserved2 = 0;
+        uint64_t entryBaseUnit = 0;
+    };
+    static_assert(std::is_trivially_copyable_v<Mem>,
+            "Type not suitable for memcpy.");
+    static_assert(sizeof(Mem) == 32, "Wrong HMAT locality record size.");
+
+    void prepareBuf(std::vector<uint8_t>& mem) const override;
+
+  public:
+    Locality(const Params& p);
+};
+
+class HMAT : public SysDescTable
+{
+  protected:
+    PARAMS(X86ACPIHmat);
+
+    struct GEM5_PACKED Mem : public SysDescTable::Mem
+    {
+        uint32_t _reserved = 0;
+    };
+    static_assert(std::is_trivially_copyable_v<Mem>,
+            "Type not suitable for memcpy.");
+
+    std::vector<Record *> records;
+
+    Addr writeBuf(PortProxy& phys_proxy, Allocator& alloc,
+            std::vector<uint8_t>& mem) const override;
+
+  public:
+    HMAT(const Params &p);
+};
+
+} // namespace HMAT
+
 } // namespace ACPI
 
 } // namespace X86ISA
@@ -284,9 +284,9 @@ SyscallDescTable<EmuLinux::SyscallABI64> EmuLinux::syscallDescs64 = {
     { 234, "tgkill", tgkillFunc<X86Linux64> },
     { 235, "utimes", utimesFunc<X86Linux64> },
     { 236, "vserver" },
-    { 237, "mbind", ignoreFunc },
-    { 238, "set_mempolicy" },
-    { 239, "get_mempolicy", ignoreFunc },
+    { 237, "mbind", mbindFunc },
+    { 238, "set_mempolicy", setMempolicyFunc },
+    { 239, "get_mempolicy", getMempolicyFunc },
     { 240, "mq_open" },
     { 241, "mq_unlink" },
     { 242, "mq_timedsend" },
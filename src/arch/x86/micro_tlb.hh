@@ -0,0 +1,99 @@
+#ifndef __ARCH_X86_MICRO_TLB_HH__
+#define __ARCH_X86_MICRO_TLB_HH__
+
+#include <vector>
+
+#include "arch/x86/page_size.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace X86ISA
+{
+    /**
+     * Direct-mapped cache of recent TLB lookups, checked before walking
+     * the trie. It is indexed by virtual page and tagged with the full
+     * lookup key, which includes the PCID, so one cache serves all
+     * contexts. The owner must invalidate an entry whenever it leaves the
+     * trie or may be shadowed by a new entry, so that a hit always
+     * returns what the trie would.
+     */
+    template <class Entry>
+    class MicroTLB
+    {
+      public:
+        /** @param size Number of slots, a power of 2. Zero disables it. */
+        explicit MicroTLB(unsigned size) : slots(size), mask(size - 1) {}
+
+        bool enabled() const { return !slots.empty(); }
+
+        /** @return The cached entry for the lookup key, or nullptr. */
+        Entry *
+        lookup(Addr va) const
+        {
+            if (!enabled())
+                return nullptr;
+            const Slot &s = slot(va);
+            return s.va == va ? s.entry : nullptr;
+        }
+
+        void
+        fill(Addr va, Entry *entry)
+        {
+            if (!enabled())
+                return;
+            Slot &s = slot(va);
+            s.va = va;
+            s.entry = entry;
+        }
+
+        /** Drop the cached lookups that resolved to an entry. */
+        void
+        invalidate(const Entry *entry)
+        {
+            for (auto &s : slots) {
+                if (s.entry == entry)
+                    s.entry = nullptr;
+            }
+        }
+
+        /** Drop the cached lookups of keys in a 2^log_bytes region. */
+        void
+        invalidateRange(Addr va, unsigned log_bytes)
+        {
+            for (auto &s : slots) {
+                if (s.entry && ((s.va ^ va) >> log_bytes) == 0)
+                    s.entry = nullptr;
+            }
+        }
+
+        void
+        flush()
+        {
+            for (auto &s : slots)
+                s.entry = nullptr;
+        }
+
+      private:
+        struct Slot
+        {
+            Addr va = 0;
+            Entry *entry = nullptr;
+        };
+
+        std::vector<Slot> slots;
+        const Addr mask;
+
+        Slot &slot(Addr va) { return slots[(va >> PageShift) & mask]; }
+        const Slot &
+        slot(Addr va) const
+        {
+            return slots[(va >> PageShift) & mask];
+        }
+    };
+
+} // namespace X86ISA
+} // namespace gem5
+
+#endif // __ARCH_X86_MICRO_TLB_HH__
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "arch/x86/micro_tlb.hh"
+
+using namespace gem5;
+using namespace gem5::X86ISA;
+
+namespace
+{
+
+struct FakeEntry
+{
+    int id;
+};
+
+constexpr Addr pageA = 0x400000;
+constexpr Addr pageB = 0x401000;
+
+} // anonymous namespace
+
+TEST(MicroTLBTest, HitAfterFill)
+{
+    MicroTLB<FakeEntry> micro(16);
+    FakeEntry a{1};
+    EXPECT_EQ(micro.lookup(pageA), nullptr);
+    micro.fill(pageA, &a);
+    EXPECT_EQ(micro.lookup(pageA), &a);
+}
+
+TEST(MicroTLBTest, DemappedPageMisses)
+{
+    // TLB::demapPage invalidates the entry it removes from the trie
+    MicroTLB<FakeEntry> micro(16);
+    FakeEntry a{1}, b{2};
+    micro.fill(pageA, &a);
+    micro.fill(pageB, &b);
+    micro.invalidate(&a);
+    EXPECT_EQ(micro.lookup(pageA), nullptr);
+    EXPECT_EQ(micro.lookup(pageB), &b);
+}
+
+TEST(MicroTLBTest, DemapDropsAllKeysOfAnEntry)
+{
+    // Several pages of a large page resolve to the same entry
+    MicroTLB<FakeEntry> micro(16);
+    FakeEntry large{1};
+    micro.fill(pageA, &large);
+    micro.fill(pageB, &large);
+    micro.invalidate(&large);
+    EXPECT_EQ(micro.lookup(pageA), nullptr);
+    EXPECT_EQ(micro.lookup(pageB), nullptr);
+}
+
+TEST(MicroTLBTest, FlushMisses)
+{
+    // TLB::flushAll, and TLB::flushNonGlobal on a CR3 or PCID change
+    MicroTLB<FakeEntry> micro(16);
+    FakeEntry a{1}, b{2};
+    micro.fill(pageA, &a);
+    micro.fill(pageB, &b);
+    micro.flush();
+    EXPECT_EQ(micro.lookup(pageA), nullptr);
+    EXPECT_EQ(micro.lookup(pageB), nullptr);
+}
+
+TEST(MicroTLBTest, PcidIsPartOfTheKey)
+{
+    MicroTLB<FakeEntry> micro(16);
+    FakeEntry a{1};
+    micro.fill(pageA | 1, &a);
+    EXPECT_EQ(micro.lookup(pageA | 1), &a);
+    EXPECT_EQ(micro.lookup(pageA | 2), nullptr);
+    EXPECT_EQ(micro.lookup(pageA), nullptr);
+}
+
+TEST(MicroTLBTest, ConflictingPagesReplaceEachOther)
+{
+    MicroTLB<FakeEntry> micro(16);
+    FakeEntry a{1}, b{2};
+    const Addr alias = pageA + 16 * PageBytes;
+    micro.fill(pageA, &a);
+    micro.fill(alias, &b);
+    EXPECT_EQ(micro.lookup(pageA), nullptr);
+    EXPECT_EQ(micro.lookup(alias), &b);
+}
+
+TEST(MicroTLBTest, InsertDropsShadowedLookups)
+{
+    // TLB::insert drops the lookups covered by a new 2MiB entry
+    MicroTLB<FakeEntry> micro(16);
+    FakeEntry a{1}, b{2};
+    const Addr outside = pageA + (Addr(1) << 21);
+    micro.fill(pageB, &a);
+    micro.fill(outside, &b);
+    micro.invalidateRange(pageA, 21);
+    EXPECT_EQ(micro.lookup(pageB), nullptr);
+    EXPECT_EQ(micro.lookup(outside), &b);
+}
+
+TEST(MicroTLBTest, Disabled)
+{
+    MicroTLB<FakeEntry> micro(0);
+    FakeEntry a{1};
+    EXPECT_FALSE(micro.enabled());
+    micro.fill(pageA, &a);
+    EXPECT_EQ(micro.lookup(pageA), nullptr);
+}
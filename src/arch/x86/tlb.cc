@@ -47,6 +47,7 @@
 #include "arch/x86/regs/misc.hh"
 #include "arch/x86/regs/msr.hh"
 #include "arch/x86/x86_traits.hh"
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "cpu/thread_context.hh"
 #include "debug/TLB.hh"
@@ -64,10 +65,13 @@ namespace X86ISA {
 
 TLB::TLB(const Params &p)
     : BaseTLB(p), configAddress(0), size(p.size),
-      tlb(size), lruSeq(0), m5opRange(p.system->m5opRange()), stats(this)
+      tlb(size), lruSeq(0), micro(p.micro_size),
+      m5opRange(p.system->m5opRange()), stats(this)
 {
     if (!size)
         fatal("TLBs must have a non-zero size.\n");
+    fatal_if(p.micro_size && !isPowerOf2(p.micro_size),
+             "TLB micro_size must be a power of 2.\n");
 
     for (int x = 0; x < size; x++) {
         tlb[x].trieHandle = NULL;
@@ -91,6 +95,7 @@ TLB::evictLRU()
     }
 
     assert(tlb[lru].trieHandle);
+    micro.invalidate(&tlb[lru]);
     trie.remove(tlb[lru].trieHandle);
     tlb[lru].trieHandle = NULL;
     freeList.push_back(&tlb[lru]);
@@ -118,6 +123,10 @@ TLB::insert(Addr vpn, const TlbEntry &entry, uint64_t pcid)
     newEntry = freeList.front();
     freeList.pop_front();
 
+    // Cached lookups of addresses covered by the new entry might resolve
+    // to it in the trie from now on, so drop them.
+    micro.invalidateRange(vpn, entry.logBytes);
+
     *newEntry = entry;
     newEntry->lruSeq = nextSeq();
     newEntry->vaddr = vpn;
@@ -135,7 +144,18 @@ TLB::insert(Addr vpn, const TlbEntry &entry, uint64_t pcid)
 TlbEntry *
 TLB::lookup(Addr va, bool update_lru)
 {
-    TlbEntry *entry = trie.lookup(va);
+    TlbEntry *entry = micro.lookup(va);
+    if (entry) {
+        stats.microHits++;
+    } else {
+        entry = trie.lookup(va);
+        if (micro.enabled()) {
+            stats.microMisses++;
+            if (entry)
+                micro.fill(va, entry);
+        }
+    }
+
     if (entry && update_lru)
         entry->lruSeq = nextSeq();
     return entry;
@@ -145,6 +165,7 @@ void
 TLB::flushAll()
 {
     DPRINTF(TLB, "Invalidating all entries.\n");
+    micro.flush();
     for (unsigned i = 0; i < size; i++) {
         if (tlb[i].trieHandle) {
             trie.remove(tlb[i].trieHandle);
@@ -164,6 +185,7 @@ void
 TLB::flushNonGlobal()
 {
     DPRINTF(TLB, "Invalidating all non global entries.\n");
+    micro.flush();
     for (unsigned i = 0; i < size; i++) {
         if (tlb[i].trieHandle && !tlb[i].global) {
             trie.remove(tlb[i].trieHandle);
@@ -178,6 +200,7 @@ TLB::demapPage(Addr va, uint64_t asn)
 {
     TlbEntry *entry = trie.lookup(va);
     if (entry) {
+        micro.invalidate(entry);
         trie.remove(entry->trieHandle);
         entry->trieHandle = NULL;
         freeList.push_back(entry);
@@ -450,10 +473,11 @@ TLB::translate(const RequestPtr &req,
                                                            true, false);
                     } else {
                         Addr alignedVaddr = p->pTable->pageAlign(vaddr);
+                        Addr pagePaddr = pte->translate(alignedVaddr);
                         DPRINTF(TLB, "Mapping %#x to %#x\n", alignedVaddr,
-                                pte->paddr);
+                                pagePaddr);
                         entry = insert(alignedVaddr, TlbEntry(
-                                p->pTable->pid(), alignedVaddr, pte->paddr,
+                                p->pTable->pid(), alignedVaddr, pagePaddr,
                                 pte->flags & EmulationPageTable::Uncacheable,
                                 pte->flags & EmulationPageTable::ReadOnly),
                                 pcid);
@@ -546,7 +570,7 @@ TLB::translateFunctional(const RequestPtr &req, ThreadContext *tc,
         if (!pte)
             return std::make_shared<PageFault>(vaddr, true, mode, true, false);
 
-        paddr = pte->paddr | process->pTable->pageOffset(vaddr);
+        paddr = pte->translate(vaddr);
     }
     DPRINTF(TLB, "Translated (functional) %#x -> %#x.\n", vaddr, paddr);
     req->setPaddr(paddr);
@@ -585,8 +609,15 @@ TLB::TlbStats::TlbStats(statistics::Group *parent)
     ADD_STAT(rdMisses, statistics::units::Count::get(),
              "TLB misses on read requests"),
     ADD_STAT(wrMisses, statistics::units::Count::get(),
-             "TLB misses on write requests")
+             "TLB misses on write requests"),
+    ADD_STAT(microHits, statistics::units::Count::get(),
+             "Lookups served by the micro-TLB, each saving a trie walk"),
+    ADD_STAT(microMisses, statistics::units::Count::get(),
+             "Lookups that missed in the micro-TLB"),
+    ADD_STAT(microHitRate, statistics::units::Ratio::get(),
+             "Micro-TLB hit rate", microHits / (microHits + microMisses))
 {
+    microHitRate.flags(statistics::nozero);
 }
 
 void
@@ -615,6 +646,7 @@ TLB::unserialize(CheckpointIn &cp)
     }
 
     UNSERIALIZE_SCALAR(lruSeq);
+    micro.flush();
 
     for (uint32_t x = 0; x < _size; x++) {
         TlbEntry *newEntry = freeList.front();
@@ -42,6 +42,7 @@
 #include <vector>
 
 #include "arch/generic/tlb.hh"
+#include "arch/x86/micro_tlb.hh"
 #include "arch/x86/pagetable.hh"
 #include "base/trie.hh"
 #include "mem/request.hh"
@@ -107,6 +108,9 @@ namespace X86ISA
         TlbEntryTrie trie;
         uint64_t lruSeq;
 
+        /** Recent lookups, checked before walking the trie. */
+        MicroTLB<TlbEntry> micro;
+
         AddrRange m5opRange;
 
         struct TlbStats : public statistics::Group
@@ -117,6 +121,9 @@ namespace X86ISA
             statistics::Scalar wrAccesses;
             statistics::Scalar rdMisses;
             statistics::Scalar wrMisses;
+            statistics::Scalar microHits;
+            statistics::Scalar microMisses;
+            statistics::Formula microHitRate;
         } stats;
 
         Fault translateInt(bool read, RequestPtr req, ThreadContext *tc);
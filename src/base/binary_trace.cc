@@ -0,0 +1,227 @@
+#include "base/binary_trace.hh"
+
+#include <atomic>
+#include <cstring>
+
+#include "base/compiler.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+namespace
+{
+
+/** Buffers waiting for the writer before logging threads are held up */
+constexpr std::size_t maxPending = 8;
+
+template <typename V>
+void
+append(std::vector<char> &data, V value)
+{
+    const char *bytes = reinterpret_cast<const char *>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(value));
+}
+
+void
+append(std::vector<char> &data, const char *str, std::size_t len)
+{
+    append(data, uint32_t(len));
+    data.insert(data.end(), str, str + len);
+}
+
+/** Tells the loggers apart, addresses may be reused */
+std::atomic<uint64_t> nextLoggerId{0};
+
+} // anonymous namespace
+
+BinaryLogger::BinaryLogger(std::ostream &_stream, std::size_t buffer_bytes)
+    : stream(_stream), bufferBytes(buffer_bytes), textBuf(*this),
+      textStream(&textBuf), loggerId(nextLoggerId++)
+{
+    raw = true;
+
+    stream.write("gem5btrc", 8);
+    stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+
+    writer = std::thread([this]() { write(); });
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    pendingCond.notify_one();
+    writer.join();
+}
+
+BinaryLogger::ThreadBuffer &
+BinaryLogger::threadBuffer()
+{
+    static thread_local uint64_t owner = ~uint64_t(0);
+    static thread_local ThreadBuffer *buffer = nullptr;
+
+    if (GEM5_UNLIKELY(owner != loggerId)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.emplace_back(std::make_unique<ThreadBuffer>());
+        buffer = threads.back().get();
+        buffer->thread = threads.size() - 1;
+        buffer->data.reserve(bufferBytes);
+        owner = loggerId;
+    }
+    return *buffer;
+}
+
+uint32_t
+BinaryLogger::stringId(ThreadBuffer &tb, const void *key,
+                       const char *str, std::size_t len)
+{
+    std::string_view contents(str, len);
+
+    if (key) {
+        auto it = tb.recent.find(key);
+        if (GEM5_LIKELY(it != tb.recent.end() &&
+                    tb.strings[it->second] == contents)) {
+            return it->second;
+        }
+    }
+
+    auto it = tb.ids.find(contents);
+    if (it == tb.ids.end()) {
+        uint32_t id = tb.strings.size();
+        const std::string &stored = tb.strings.emplace_back(contents);
+        it = tb.ids.emplace(stored, id).first;
+
+        tb.data.push_back('D');
+        append(tb.data, id);
+        append(tb.data, str, len);
+    }
+    if (key)
+        tb.recent[key] = it->second;
+    return it->second;
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!isEnabled(name))
+        return;
+
+    ThreadBuffer &tb = threadBuffer();
+    uint32_t name_id = stringId(tb, &name, name.data(), name.size());
+    uint32_t flag_id = stringId(tb, nullptr, flag.data(), flag.size());
+
+    tb.data.push_back('T');
+    append(tb.data, uint64_t(when));
+    append(tb.data, name_id);
+    append(tb.data, flag_id);
+    append(tb.data, message.data(), message.size());
+    release(tb);
+}
+
+void
+BinaryLogger::logRaw(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt, const RawArgs &args)
+{
+    ThreadBuffer &tb = threadBuffer();
+    uint32_t name_id = stringId(tb, &name, name.data(), name.size());
+    // Flags arrive as temporaries, only their contents identify them
+    uint32_t flag_id = stringId(tb, nullptr, flag.data(), flag.size());
+    uint32_t fmt_id = stringId(tb, fmt, fmt, std::strlen(fmt));
+
+    tb.data.push_back('M');
+    append(tb.data, uint64_t(when));
+    append(tb.data, name_id);
+    append(tb.data, flag_id);
+    append(tb.data, fmt_id);
+    append(tb.data, args.data(), args.size());
+    release(tb);
+}
+
+void
+BinaryLogger::handOff(ThreadBuffer &tb)
+{
+    std::vector<char> fresh;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        // Do not let the simulation run away from the writer
+        writtenCond.wait(lock, [this]() {
+            return pending.size() < maxPending;
+        });
+        pending.emplace_back(tb.thread, std::move(tb.data));
+        if (!spare.empty()) {
+            fresh = std::move(spare.back());
+            spare.pop_back();
+        }
+    }
+    pendingCond.notify_one();
+
+    fresh.reserve(bufferBytes);
+    tb.data = std::move(fresh);
+}
+
+void
+BinaryLogger::write()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        pendingCond.wait(lock, [this]() {
+            return stopping || !pending.empty();
+        });
+        if (pending.empty())
+            break;
+
+        auto [thread, data] = std::move(pending.front());
+        pending.pop_front();
+        writing = true;
+        lock.unlock();
+
+        uint32_t bytes = data.size();
+        stream.write(reinterpret_cast<const char *>(&thread),
+                     sizeof(thread));
+        stream.write(reinterpret_cast<const char *>(&bytes), sizeof(bytes));
+        stream.write(data.data(), bytes);
+        data.clear();
+
+        lock.lock();
+        spare.push_back(std::move(data));
+        writing = false;
+        writtenCond.notify_all();
+    }
+}
+
+void
+BinaryLogger::flush()
+{
+    textStream.flush();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (auto &tb: threads) {
+        if (!tb->data.empty()) {
+            pending.emplace_back(tb->thread, std::move(tb->data));
+            tb->data = std::vector<char>();
+        }
+    }
+    pendingCond.notify_one();
+    writtenCond.wait(lock, [this]() { return pending.empty() && !writing; });
+    stream.flush();
+}
+
+int
+BinaryLogger::TextBuf::sync()
+{
+    if (!str().empty()) {
+        logger.logMessage(MaxTick, "", "", str());
+        str("");
+    }
+    return 0;
+}
+
+} // namespace trace
+} // namespace gem5
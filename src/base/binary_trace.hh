@@ -0,0 +1,158 @@
+#ifndef __BASE_BINARY_TRACE_HH__
+#define __BASE_BINARY_TRACE_HH__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base/trace.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+/**
+ * Debug logger that writes a compact binary trace instead of text. Messages
+ * are stored as the IDs of their format string, object name and flag plus
+ * their raw arguments (see RawArgs), so no formatting happens while
+ * simulating. util/decode_binary_trace.py turns the trace back into the
+ * text the OstreamLogger would have printed.
+ *
+ * Every thread logs into its own buffer, which is handed to a writer
+ * thread once full, so compressing and writing the trace overlaps with
+ * the simulation. The strings a buffer refers to are defined in the same
+ * or an earlier buffer of the same thread.
+ *
+ * The trace is a header followed by chunks, each holding the records of
+ * one buffer. All values are in host byte order:
+ *
+ *   header:  "gem5btrc" u32 version
+ *   chunk:   u32 thread u32 bytes records...
+ *   'D':     u32 id u32 length chars           defines a string
+ *   'M':     u64 tick u32 name u32 flag u32 format u32 bytes args...
+ *   'T':     u64 tick u32 name u32 flag u32 length chars
+ *
+ * 'M' records are messages logged through DPRINTF and friends, 'T' records
+ * are messages that were already formatted, e.g., DDUMPs or text written
+ * to getOstream().
+ */
+class BinaryLogger : public Logger
+{
+  public:
+    static constexpr uint32_t version = 1;
+
+    /**
+     * @param stream Stream to write the trace to. Only the writer thread
+     *               uses it once the logger has been created.
+     * @param buffer_bytes Size of the buffer of each thread.
+     */
+    BinaryLogger(std::ostream &stream, std::size_t buffer_bytes = 1 << 20);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    void logRaw(Tick when, const std::string &name, const std::string &flag,
+            const char *fmt, const RawArgs &args) override;
+
+    /** A stream whose text ends up in 'T' records when it is flushed */
+    std::ostream &getOstream() override { return textStream; }
+
+    /**
+     * Writes out the buffers of all threads and waits for them to reach
+     * the stream. Must not race with threads that are logging, e.g., call
+     * it on exit.
+     */
+    void flush();
+
+  private:
+    /** Logging state of a thread */
+    struct ThreadBuffer
+    {
+        uint32_t thread;
+        std::vector<char> data;
+
+        /** The strings defined so far, their index is their ID */
+        std::deque<std::string> strings;
+        /** IDs of the strings defined so far, by contents */
+        std::unordered_map<std::string_view, uint32_t> ids;
+        /**
+         * IDs by the address of the string, checked against the contents
+         * since addresses may be reused. Format strings are literals and
+         * names usually belong to the SimObjects, so lookups rarely need
+         * to hash the string.
+         */
+        std::unordered_map<const void *, uint32_t> recent;
+    };
+
+    class TextBuf : public std::stringbuf
+    {
+      private:
+        BinaryLogger &logger;
+
+      public:
+        TextBuf(BinaryLogger &_logger) : logger(_logger) {}
+
+        int sync() override;
+    };
+
+    /** The buffer of the calling thread */
+    ThreadBuffer &threadBuffer();
+
+    /** ID of a string, defining it if it is new to the thread */
+    uint32_t stringId(ThreadBuffer &tb, const void *key,
+                      const char *str, std::size_t len);
+
+    /** Hands the buffer of a thread to the writer if it is full */
+    void
+    release(ThreadBuffer &tb)
+    {
+        if (tb.data.size() >= bufferBytes)
+            handOff(tb);
+    }
+
+    void handOff(ThreadBuffer &tb);
+
+    /** Main loop of the writer thread */
+    void write();
+
+    std::ostream &stream;
+    const std::size_t bufferBytes;
+
+    TextBuf textBuf;
+    std::ostream textStream;
+
+    /** Identifies the logger to the threads, see threadBuffer() */
+    const uint64_t loggerId;
+
+    std::mutex mutex;
+    std::condition_variable pendingCond;
+    std::condition_variable writtenCond;
+    /** Full buffers waiting for the writer */
+    std::deque<std::pair<uint32_t, std::vector<char>>> pending;
+    /** Written buffers to reuse */
+    std::vector<std::vector<char>> spare;
+    /** Whether the writer is busy with a buffer */
+    bool writing = false;
+    bool stopping = false;
+
+    std::vector<std::unique_ptr<ThreadBuffer>> threads;
+    std::thread writer;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __BASE_BINARY_TRACE_HH__
@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/binary_trace.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** A decoded record of a binary trace */
+struct Record
+{
+    uint32_t thread;
+    char kind;
+    Tick when;
+    std::string name;
+    std::string flag;
+    /** Format of 'M' records, message of 'T' records */
+    std::string text;
+    std::string args;
+};
+
+template <typename V>
+V
+read(const std::string &data, std::size_t &pos)
+{
+    V value;
+    std::memcpy(&value, data.data() + pos, sizeof(value));
+    pos += sizeof(value);
+    return value;
+}
+
+std::string
+readString(const std::string &data, std::size_t &pos)
+{
+    auto len = read<uint32_t>(data, pos);
+    std::string str = data.substr(pos, len);
+    pos += len;
+    return str;
+}
+
+/** Parses a binary trace, see base/binary_trace.hh */
+std::vector<Record>
+parse(const std::string &data)
+{
+    EXPECT_EQ(data.substr(0, 8), "gem5btrc");
+    std::size_t pos = 8;
+    EXPECT_EQ(read<uint32_t>(data, pos), trace::BinaryLogger::version);
+
+    std::vector<Record> records;
+    std::map<uint32_t, std::map<uint32_t, std::string>> strings;
+    while (pos < data.size()) {
+        auto thread = read<uint32_t>(data, pos);
+        auto end = pos + read<uint32_t>(data, pos);
+        auto &defs = strings[thread];
+        while (pos < end) {
+            char kind = data[pos++];
+            if (kind == 'D') {
+                auto id = read<uint32_t>(data, pos);
+                EXPECT_EQ(defs.count(id), 0u);
+                defs[id] = readString(data, pos);
+                continue;
+            }
+            Record r;
+            r.thread = thread;
+            r.kind = kind;
+            r.when = read<uint64_t>(data, pos);
+            r.name = defs.at(read<uint32_t>(data, pos));
+            r.flag = defs.at(read<uint32_t>(data, pos));
+            if (kind == 'M') {
+                r.text = defs.at(read<uint32_t>(data, pos));
+                r.args = readString(data, pos);
+            } else {
+                EXPECT_EQ(kind, 'T');
+                r.text = readString(data, pos);
+            }
+            records.push_back(r);
+        }
+        EXPECT_EQ(pos, end);
+    }
+    return records;
+}
+
+} // anonymous namespace
+
+TEST(BinaryTraceTest, Messages)
+{
+    std::stringstream stream;
+    {
+        trace::BinaryLogger logger(stream, 64);
+        const std::string name = "system.cxl";
+        for (int i = 0; i < 10; i++) {
+            logger.dprintf_flag(i, name, "CXLMemory", "addr %#x size %d\n",
+                                uint64_t(0x1000 + i), i);
+        }
+        logger.dprintf(20, name, "%s %c\n", "str", 'c');
+    }
+
+    auto records = parse(stream.str());
+    ASSERT_EQ(records.size(), 11u);
+    for (int i = 0; i < 10; i++) {
+        const Record &r = records[i];
+        EXPECT_EQ(r.kind, 'M');
+        EXPECT_EQ(r.when, Tick(i));
+        EXPECT_EQ(r.name, "system.cxl");
+        EXPECT_EQ(r.flag, "CXLMemory");
+        EXPECT_EQ(r.text, "addr %#x size %d\n");
+
+        std::string args;
+        args += 'u';
+        uint64_t addr = 0x1000 + i;
+        args.append(reinterpret_cast<const char *>(&addr), sizeof(addr));
+        args += 'i';
+        args += char(sizeof(int));
+        int64_t size = i;
+        args.append(reinterpret_cast<const char *>(&size), sizeof(size));
+        EXPECT_EQ(r.args, args);
+    }
+
+    EXPECT_EQ(records[10].flag, "");
+    std::string args = "s";
+    uint32_t len = 3;
+    args.append(reinterpret_cast<const char *>(&len), sizeof(len));
+    args += "strc";
+    args += 'c';
+    EXPECT_EQ(records[10].args, args);
+}
+
+TEST(BinaryTraceTest, TextMessages)
+{
+    std::stringstream stream;
+    {
+        trace::BinaryLogger logger(stream);
+        logger.logMessage(5, "obj", "Flag", "preformatted\n");
+        logger.getOstream() << "some text" << std::endl;
+        logger.getOstream() << "unflushed";
+    }
+
+    auto records = parse(stream.str());
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0].kind, 'T');
+    EXPECT_EQ(records[0].when, 5u);
+    EXPECT_EQ(records[0].name, "obj");
+    EXPECT_EQ(records[0].flag, "Flag");
+    EXPECT_EQ(records[0].text, "preformatted\n");
+    EXPECT_EQ(records[1].when, MaxTick);
+    EXPECT_EQ(records[1].text, "some text\n");
+    EXPECT_EQ(records[2].text, "unflushed");
+}
+
+/** Names with the same address but different contents get their own ID */
+TEST(BinaryTraceTest, ReusedNameAddress)
+{
+    std::stringstream stream;
+    {
+        trace::BinaryLogger logger(stream);
+        std::string name = "first";
+        logger.dprintf(0, name, "msg\n");
+        name = "second";
+        logger.dprintf(1, name, "msg\n");
+        name = "first";
+        logger.dprintf(2, name, "msg\n");
+    }
+
+    auto records = parse(stream.str());
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0].name, "first");
+    EXPECT_EQ(records[1].name, "second");
+    EXPECT_EQ(records[2].name, "first");
+}
+
+TEST(BinaryTraceTest, Threads)
+{
+    constexpr int messages = 10000;
+    std::stringstream stream;
+    {
+        trace::BinaryLogger logger(stream, 1024);
+        auto log = [&](const std::string &name) {
+            for (int i = 0; i < messages; i++)
+                logger.dprintf(i, name, "message %d\n", i);
+        };
+        std::thread t0(log, "t0"), t1(log, "t1");
+        t0.join();
+        t1.join();
+        logger.flush();
+    }
+
+    // Messages of a thread stay in order
+    std::map<std::string, Tick> next;
+    for (const auto &r: parse(stream.str()))
+        EXPECT_EQ(r.when, next[r.name]++);
+    EXPECT_EQ(next["t0"], messages);
+    EXPECT_EQ(next["t1"], messages);
+}
+
+TEST(BinaryTraceTest, IgnoredObjects)
+{
+    std::stringstream stream;
+    {
+        trace::BinaryLogger logger(stream);
+        logger.addIgnore(ObjectMatch("ignored"));
+        logger.dprintf(0, "ignored", "msg\n");
+        logger.dprintf(1, "kept", "msg\n");
+    }
+
+    auto records = parse(stream.str());
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].name, "kept");
+}
+
+/**
+ * Time and bytes per message for DPRINTFs like those of the CXL devices,
+ * with the text and the binary logger. Disabled by default; run with
+ * --gtest_also_run_disabled_tests.
+ */
+TEST(BinaryTraceTest, DISABLED_LoggerThroughput)
+{
+    constexpr int messages = 1 << 21;
+    const std::string name = "system.pc.south_bridge.cxlmemory";
+    const std::string cmd = "ReadReq";
+
+    using Clock = std::chrono::steady_clock;
+    auto run = [&](trace::Logger &logger) {
+        auto start = Clock::now();
+        for (int i = 0; i < messages; i++) {
+            logger.dprintf_flag(i * 500, name, "CXLMemory",
+                    "recvTimingReq: %s addr %#x size %d, %d queued\n",
+                    cmd, uint64_t(0x100000000) + i * 64, 64, i % 32);
+        }
+        if (auto binary = dynamic_cast<trace::BinaryLogger *>(&logger))
+            binary->flush();
+        std::chrono::duration<double> secs = Clock::now() - start;
+        return secs.count() * 1e9 / messages;
+    };
+
+    std::ostringstream text;
+    trace::OstreamLogger text_logger(text);
+    double text_ns = run(text_logger);
+
+    std::ostringstream binary;
+    double binary_ns;
+    {
+        trace::BinaryLogger binary_logger(binary);
+        binary_ns = run(binary_logger);
+    }
+
+    std::cout << "Text:   " << text_ns << " ns/msg, "
+              << double(text.str().size()) / messages << " bytes/msg\n"
+              << "Binary: " << binary_ns << " ns/msg, "
+              << double(binary.str().size()) / messages << " bytes/msg\n";
+}
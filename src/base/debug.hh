@@ -113,6 +113,29 @@ class SimpleFlag : public Flag
     bool isFormat() const { return _isFormat; }
 };
 
+/**
+ * Stand-in for a SimpleFlag that is compiled out of non-debug builds, see
+ * PRUNED_DEBUG_FLAGS. It is off at compile time, so the compiler removes
+ * the DPRINTFs that use it together with the evaluation of their
+ * arguments. The flag itself still exists and can be enabled, which has no
+ * effect.
+ */
+class PrunedFlag
+{
+  private:
+    const SimpleFlag &flag;
+
+  public:
+    constexpr PrunedFlag(const SimpleFlag &_flag) : flag(_flag) {}
+
+    std::string name() const { return flag.name(); }
+    std::string desc() const { return flag.desc(); }
+
+    constexpr bool tracing() const { return false; }
+
+    constexpr operator bool() const { return false; }
+};
+
 class CompoundFlag : public Flag
 {
   protected:
@@ -144,6 +144,13 @@ Logger::dump(Tick when, const std::string &name,
     }
 }
 
+void
+Logger::logRaw(Tick when, const std::string &name, const std::string &flag,
+        const char *fmt, const RawArgs &args)
+{
+    panic("This debug logger cannot log unformatted messages.");
+}
+
 void
 OstreamLogger::logMessage(Tick when, const std::string &name,
         const std::string &flag, const std::string &message)
@@ -32,9 +32,12 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <cstdint>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <sstream>
+#include <type_traits>
 
 #include "base/compiler.hh"
 #include "base/cprintf.hh"
@@ -54,6 +57,90 @@ namespace gem5
 
 namespace trace {
 
+/**
+ * The arguments of a debug message, packed without formatting them as the
+ * binary trace stores them. Integers, floating point numbers, characters,
+ * pointers and strings are kept as they are, values of other types are
+ * formatted into strings.
+ */
+class RawArgs
+{
+  public:
+    enum Tag : char
+    {
+        Bool = 'b',
+        Char = 'c',
+        Int = 'i',
+        UInt = 'u',
+        Float = 'f',
+        Pointer = 'p',
+        String = 's'
+    };
+
+    template <typename ...Args>
+    RawArgs(const Args &...args)
+    {
+        buf.clear();
+        (add(args), ...);
+    }
+
+    const char *data() const { return buf.data(); }
+    std::size_t size() const { return buf.size(); }
+
+  private:
+    // One buffer per thread, so packing does not allocate once it has grown
+    static inline thread_local std::string buf;
+
+    template <typename V>
+    void
+    put(Tag tag, V value)
+    {
+        buf.push_back(tag);
+        buf.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    void
+    putString(std::string_view str)
+    {
+        put(String, uint32_t(str.size()));
+        buf.append(str.data(), str.size());
+    }
+
+    template <typename T>
+    void
+    add(const T &arg)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            put(Bool, uint8_t(arg));
+        } else if constexpr (std::is_same_v<T, char> ||
+                std::is_same_v<T, signed char> ||
+                std::is_same_v<T, unsigned char>) {
+            put(Char, uint8_t(arg));
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            // The size tells how negative values print in hex and octal
+            put(Int, uint8_t(sizeof(T)));
+            int64_t value = arg;
+            buf.append(reinterpret_cast<const char *>(&value), sizeof(value));
+        } else if constexpr (std::is_integral_v<T>) {
+            put(UInt, uint64_t(arg));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            put(Float, double(arg));
+        } else if constexpr (std::is_convertible_v<const T &, const char *>) {
+            const char *str = arg;
+            putString(str ? str : "(null)");
+        } else if constexpr (std::is_same_v<T, std::string> ||
+                std::is_same_v<T, std::string_view>) {
+            putString(arg);
+        } else if constexpr (std::is_pointer_v<T>) {
+            put(Pointer, uint64_t(reinterpret_cast<uintptr_t>(arg)));
+        } else {
+            std::ostringstream str;
+            ccprintf(str, "%s", arg);
+            putString(str.str());
+        }
+    }
+};
+
 /** Debug logging base class.  Handles formatting and outputting
  *  time/name/message messages */
 class Logger
@@ -63,6 +150,8 @@ class Logger
     ObjectMatch ignore;
     /** Name match for objects to activate log */
     ObjectMatch activate;
+    /** Whether messages are passed to logRaw() without formatting them */
+    bool raw = false;
 
     bool isEnabled(const std::string &name) const
     {
@@ -96,6 +185,10 @@ class Logger
     {
         if (!isEnabled(name))
             return;
+        if (raw) {
+            logRaw(when, name, flag, fmt, RawArgs(args...));
+            return;
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -109,6 +202,10 @@ class Logger
     virtual void logMessage(Tick when, const std::string &name,
             const std::string &flag, const std::string &message) = 0;
 
+    /** Log a message whose arguments have not been formatted yet */
+    virtual void logRaw(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt, const RawArgs &args);
+
     /** Return an ostream that can be used to send messages to
      *  the 'same place' as formatted logMessage messages.  This
      *  can be implemented to use a logger's underlying ostream,
@@ -28,6 +28,8 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <iostream>
 #include <sstream>
 #include <string>
 
@@ -55,6 +57,10 @@ namespace debug
 /** Debug flag used for the tests in this file. */
 SimpleFlag TraceTestDebugFlag("TraceTestDebugFlag",
     "Exclusive debug flag for the trace tests");
+/** Debug flag compiled out, as with PRUNED_DEBUG_FLAGS. */
+SimpleFlag TraceTestPrunedFlagImpl("TraceTestPrunedFlag",
+    "Exclusive pruned debug flag for the trace tests");
+constexpr PrunedFlag TraceTestPrunedFlag(TraceTestPrunedFlagImpl);
 } // namespace debug
 } // namespace gem5
 
@@ -685,3 +691,69 @@ TEST(TraceTest, GlobalName)
     DPRINTF(TraceTestDebugFlag, "Test message");
     ASSERT_EQ(getString(trace::output()), "");
 }
+
+/** Test that DPRINTFs with a pruned flag never print. */
+TEST(TraceTest, MacroDPRINTFPruned)
+{
+    static_assert(!debug::TraceTestPrunedFlag);
+    EXPECT_EQ(debug::TraceTestPrunedFlag.name(), "TraceTestPrunedFlag");
+
+    trace::enable();
+    EXPECT_TRUE(debug::changeFlag("TraceTestPrunedFlag", true));
+    int evaluated = 0;
+    DPRINTF(TraceTestPrunedFlag, "Test message %d", ++evaluated);
+    DPRINTFR(TraceTestPrunedFlag, "Test message %d", ++evaluated);
+    DPRINTFV(debug::TraceTestPrunedFlag, "Test message %d", ++evaluated);
+    ASSERT_EQ(getString(trace::output()), "");
+    EXPECT_EQ(evaluated, 0);
+
+    trace::disable();
+    EXPECT_TRUE(debug::changeFlag("TraceTestPrunedFlag", false));
+}
+
+namespace
+{
+
+/** Models the DPRINTFs the CXL devices issue for every packet */
+template <typename Flag>
+unsigned
+tracedPacketPath(const Flag &flag, unsigned packets)
+{
+    unsigned queued = 0;
+    for (unsigned pkt = 0; pkt < packets; pkt++) {
+        DPRINTFV(flag, "recvTimingReq: %s addr %#x\n",
+                 std::to_string(pkt), pkt * 64);
+        queued += pkt & 1;
+        DPRINTFV(flag, "trySendTiming: response queue size %d\n", queued);
+        queued -= pkt & 1;
+        DPRINTFV(flag, "recvTimingResp: %s\n", std::to_string(pkt));
+    }
+    return queued;
+}
+
+} // anonymous namespace
+
+/**
+ * Cost of disabled DPRINTFs on a packet path, with the flag off at run time
+ * and with the flag pruned. Disabled by default; run with
+ * --gtest_also_run_disabled_tests.
+ */
+TEST(TraceTest, DISABLED_DisabledDPRINTFOverhead)
+{
+    constexpr unsigned packets = 1 << 28;
+
+    using Clock = std::chrono::steady_clock;
+    auto run = [&](const auto &flag) {
+        auto start = Clock::now();
+        EXPECT_EQ(tracedPacketPath(flag, packets), 0u);
+        std::chrono::duration<double> secs = Clock::now() - start;
+        return secs.count() * 1e9 / packets;
+    };
+
+    EXPECT_TRUE(debug::changeFlag("TraceTestDebugFlag", false));
+    double runtime_ns = run(debug::TraceTestDebugFlag);
+    double pruned_ns = run(debug::TraceTestPrunedFlag);
+
+    std::cout << "Flag off:    " << runtime_ns << " ns/packet\n"
+              << "Flag pruned: " << pruned_ns << " ns/packet\n";
+}
@@ -29,10 +29,12 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
+#include <array>
 #include <unordered_map>
 
 #include "base/bitfield.hh"
 #include "base/compiler.hh"
+#include "base/types.hh"
 #include "cpu/static_inst_fwd.hh"
 
 namespace gem5
@@ -46,11 +48,19 @@ template <typename EMI>
 using InstMap = std::unordered_map<EMI, StaticInstPtr>;
 
 /// A sparse map from an Addr to a Value, stored in page chunks.
-template<class Value, Addr CacheChunkShift = 12>
+///
+/// Lookups go through two direct-indexed levels: a small table of chunks
+/// indexed by the page number of the address, then the chunk itself
+/// indexed by the page offset. The chunk of the previous lookup is checked
+/// first since consecutive fetches usually hit the same page. Only pages
+/// that conflict in the table fall back to the hash map, which owns the
+/// chunks.
+template<class Value, Addr CacheChunkShift = 12, unsigned TableShift = 8>
 class AddrMap
 {
   protected:
     static constexpr Addr CacheChunkBytes = 1ULL << CacheChunkShift;
+    static constexpr unsigned TableEntries = 1U << TableShift;
 
     static constexpr Addr
     chunkOffset(Addr addr)
@@ -64,6 +74,15 @@ class AddrMap
         return addr & ~(CacheChunkBytes - 1);
     }
 
+    static constexpr unsigned
+    tableIndex(Addr addr)
+    {
+        return (addr >> CacheChunkShift) & (TableEntries - 1);
+    }
+
+    // Never the start of a chunk, marks empty table entries.
+    static constexpr Addr InvalidStart = ~Addr(0);
+
     // A chunk of cache entries.
     struct CacheChunk
     {
@@ -71,60 +90,71 @@ class AddrMap
     };
     // A map of cache chunks which allows a sparse mapping.
     typedef typename std::unordered_map<Addr, CacheChunk *> ChunkMap;
-    typedef typename ChunkMap::iterator ChunkIt;
-    // Mini cache of recent lookups.
-    ChunkIt recent[2];
     ChunkMap chunkMap;
 
-    /// Update the mini cache of recent lookups.
-    /// @param recentest The most recent result;
-    void
-    update(ChunkIt recentest)
+    struct TableEntry
     {
-        recent[1] = recent[0];
-        recent[0] = recentest;
+        Addr start = InvalidStart;
+        CacheChunk *chunk = nullptr;
+    };
+    // Direct-indexed table of recently used chunks.
+    std::array<TableEntry, TableEntries> table;
+    // The chunk of the most recent lookup.
+    TableEntry last;
+
+    /// Find the CacheChunk which goes with a particular address, creating
+    /// it if necessary, and install it in the table.
+    /// @param addr The address to look up.
+    CacheChunk *
+    fillChunk(Addr addr)
+    {
+        Addr chunk_addr = chunkStart(addr);
+
+        CacheChunk *&chunk = chunkMap[chunk_addr];
+        if (!chunk)
+            chunk = new CacheChunk();
+
+        TableEntry &entry = table[tableIndex(addr)];
+        entry.start = chunk_addr;
+        entry.chunk = chunk;
+        return chunk;
     }
 
     /// Attempt to find the CacheChunk which goes with a particular
-    /// address. First check the small cache of recent results, then
-    /// actually look in the hash map.
+    /// address. First check the chunk of the previous lookup, then the
+    /// table, and only then the hash map.
     /// @param addr The address to look up.
     CacheChunk *
     getChunk(Addr addr)
     {
         Addr chunk_addr = chunkStart(addr);
 
-        // Check against recent lookups.
-        if (recent[0] != chunkMap.end()) {
-            if (recent[0]->first == chunk_addr)
-                return recent[0]->second;
-            if (recent[1] != chunkMap.end() &&
-                    recent[1]->first == chunk_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
-        }
+        if (GEM5_LIKELY(last.start == chunk_addr))
+            return last.chunk;
 
-        // Actually look in the hash_map.
-        ChunkIt it = chunkMap.find(chunk_addr);
-        if (it != chunkMap.end()) {
-            update(it);
-            return it->second;
+        const TableEntry &entry = table[tableIndex(addr)];
+        if (GEM5_LIKELY(entry.start == chunk_addr)) {
+            last = entry;
+            return entry.chunk;
         }
 
-        // Didn't find an existing chunk, so add a new one.
-        CacheChunk *newChunk = new CacheChunk;
-        typename ChunkMap::value_type to_insert(chunk_addr, newChunk);
-        update(chunkMap.insert(to_insert).first);
-        return newChunk;
+        CacheChunk *chunk = fillChunk(addr);
+        last.start = chunk_addr;
+        last.chunk = chunk;
+        return chunk;
     }
 
   public:
     /// Constructor
-    AddrMap()
+    AddrMap() = default;
+
+    AddrMap(const AddrMap &) = delete;
+    AddrMap &operator=(const AddrMap &) = delete;
+
+    ~AddrMap()
     {
-        recent[0] = recent[1] = chunkMap.end();
+        for (auto &chunk: chunkMap)
+            delete chunk.second;
     }
 
     Value &
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cpu/decode_cache.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Exposes the number of chunks the map has allocated */
+template <class Value, Addr Shift = 12, unsigned TableShift = 8>
+class TestAddrMap : public decode_cache::AddrMap<Value, Shift, TableShift>
+{
+  public:
+    std::size_t numChunks() const { return this->chunkMap.size(); }
+};
+
+/**
+ * Fetch addresses of a synthetic program: a loop spread over a few pages
+ * that calls into functions scattered over a large text segment.
+ */
+std::vector<Addr>
+fetchTrace(std::size_t length)
+{
+    std::mt19937_64 rng(1);
+    const Addr text = 0x400000;
+    std::vector<Addr> funcs;
+    for (int i = 0; i < 512; i++)
+        funcs.push_back(text + (rng() % (16 << 20)));
+
+    std::vector<Addr> trace;
+    trace.reserve(length);
+    Addr pc = text;
+    while (trace.size() < length) {
+        // Straight-line code with variable length instructions
+        for (int i = 0; i < 8 && trace.size() < length; i++) {
+            trace.push_back(pc);
+            pc += 1 + rng() % 7;
+        }
+        if (rng() % 2 == 0) {
+            Addr ret = pc;
+            pc = funcs[rng() % funcs.size()];
+            for (int i = 0; i < 6 && trace.size() < length; i++) {
+                trace.push_back(pc);
+                pc += 1 + rng() % 7;
+            }
+            pc = ret;
+        }
+        if (pc > text + 3 * 4096)
+            pc = text;
+    }
+    return trace;
+}
+
+} // anonymous namespace
+
+TEST(DecodeCacheAddrMapTest, LookupIsStable)
+{
+    TestAddrMap<int> map;
+    map.lookup(0x1000) = 1;
+    map.lookup(0x1fff) = 2;
+    map.lookup(0x2000) = 3;
+    EXPECT_EQ(map.lookup(0x1000), 1);
+    EXPECT_EQ(map.lookup(0x1fff), 2);
+    EXPECT_EQ(map.lookup(0x2000), 3);
+    EXPECT_EQ(&map.lookup(0x1000), &map.lookup(0x1000));
+    EXPECT_EQ(map.numChunks(), 2u);
+}
+
+TEST(DecodeCacheAddrMapTest, ConflictingPages)
+{
+    // A two entry table, so these pages all map to the same entry
+    TestAddrMap<int, 12, 1> map;
+    const Addr pages[] = { 0x0, 0x2000, 0x4000, 0xffff'ffff'ffff'e000 };
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 4; i++) {
+            int &value = map.lookup(pages[i] + 0x10);
+            if (round == 0)
+                value = i;
+            EXPECT_EQ(value, i);
+        }
+    }
+    EXPECT_EQ(map.numChunks(), 4u);
+}
+
+TEST(DecodeCacheAddrMapTest, HighAddresses)
+{
+    TestAddrMap<int> map;
+    // The last page of the address space and kernel addresses
+    map.lookup(~Addr(0)) = 1;
+    map.lookup(0xffff'ffff'8100'0000) = 2;
+    EXPECT_EQ(map.lookup(~Addr(0)), 1);
+    EXPECT_EQ(map.lookup(0xffff'ffff'8100'0000), 2);
+    EXPECT_EQ(map.lookup(~Addr(0) - 4095), 0);
+}
+
+TEST(DecodeCacheAddrMapTest, MatchesHashMap)
+{
+    TestAddrMap<Addr> map;
+    std::unordered_map<Addr, Addr> ref;
+    for (Addr pc: fetchTrace(100000)) {
+        Addr &value = map.lookup(pc);
+        auto it = ref.find(pc);
+        EXPECT_EQ(value, it == ref.end() ? 0 : it->second);
+        value = pc * 3;
+        ref[pc] = value;
+    }
+}
+
+namespace
+{
+
+/** The previous AddrMap: a hash map of chunks and two recent lookups */
+template <class Value>
+class HashAddrMap
+{
+    struct CacheChunk { Value items[4096]; };
+    std::unordered_map<Addr, CacheChunk *> chunkMap;
+    std::pair<Addr, CacheChunk *> recent[2] = {
+        { ~Addr(0), nullptr }, { ~Addr(0), nullptr } };
+
+  public:
+    ~HashAddrMap() { for (auto &c: chunkMap) delete c.second; }
+
+    Value &
+    lookup(Addr addr)
+    {
+        Addr chunk_addr = addr & ~Addr(4095);
+        if (recent[0].first != chunk_addr) {
+            if (recent[1].first == chunk_addr) {
+                std::swap(recent[0], recent[1]);
+            } else {
+                auto it = chunkMap.find(chunk_addr);
+                if (it == chunkMap.end())
+                    it = chunkMap.emplace(chunk_addr, new CacheChunk).first;
+                recent[1] = recent[0];
+                recent[0] = *it;
+            }
+        }
+        return recent[0].second->items[addr & 4095];
+    }
+};
+
+} // anonymous namespace
+
+// Decoder lookups for the fetch stream of a synthetic program, against the
+// previous hash map. Disabled by default; run with
+// --gtest_also_run_disabled_tests.
+TEST(DecodeCacheAddrMapTest, DISABLED_FetchThroughput)
+{
+    constexpr int iters = 200;
+    const std::vector<Addr> trace = fetchTrace(1 << 16);
+
+    using Clock = std::chrono::steady_clock;
+    auto run = [&](auto &map) {
+        std::uint64_t sum = 0;
+        auto start = Clock::now();
+        for (int i = 0; i < iters; i++) {
+            for (Addr pc: trace)
+                sum += map.lookup(pc)++;
+        }
+        std::chrono::duration<double> secs = Clock::now() - start;
+        EXPECT_NE(sum, 0u);
+        return iters * trace.size() / secs.count();
+    };
+
+    auto hash_map = std::make_unique<HashAddrMap<std::uint32_t>>();
+    double hash_rate = run(*hash_map);
+    auto addr_map = std::make_unique<TestAddrMap<std::uint32_t>>();
+    double table_rate = run(*addr_map);
+
+    std::cout << "Hash map:    " << hash_rate << " lookups/s\n"
+              << "Page table:  " << table_rate << " lookups/s\n";
+}
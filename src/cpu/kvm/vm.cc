@@ -372,12 +372,20 @@ KvmVM::delayedStartup()
 
     DPRINTF(Kvm, "Mapping %i memory region(s)\n", memories.size());
     for (int slot(0); slot < memories.size(); ++slot) {
+        const AddrRange &range(memories[slot].range);
+
         if (!memories[slot].kvmMap) {
             DPRINTF(Kvm, "Skipping region marked as not usable by KVM\n");
+            // Every guest access to such a region exits to gem5 and goes
+            // through the memory system as MMIO, which is very slow for
+            // memory the guest uses as RAM (e.g., CXL memory).
+            warn_if(memories[slot].inAddrMap,
+                    "KVM: Memory %s is not mapped into the VM, guest "
+                    "accesses to it are handled as MMIO.\n",
+                    range.to_string());
             continue;
         }
 
-        const AddrRange &range(memories[slot].range);
         void *pmem(memories[slot].pmem);
 
         if (pmem) {
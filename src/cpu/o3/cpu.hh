@@ -93,7 +93,7 @@ class ThreadContext;
 class CPU : public BaseCPU
 {
   public:
-    typedef std::list<DynInstPtr>::iterator ListIt;
+    typedef DynInstList::iterator ListIt;
 
     friend class ThreadContext;
 
@@ -378,7 +378,7 @@ class CPU : public BaseCPU
 #endif
 
     /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    DynInstList instList;
 
     /** List of all the instructions that will be removed at the end of this
      *  cycle.
@@ -42,6 +42,7 @@
 #define __CPU_O3_DEP_GRAPH_HH__
 
 #include "cpu/o3/comm.hh"
+#include "cpu/o3/inst_pool.hh"
 
 namespace gem5
 {
@@ -58,6 +59,20 @@ class DependencyEntry
         : inst(NULL), next(NULL)
     { }
 
+    // Entries are created and destroyed for every dependence of every
+    // instruction, so recycle them through the instruction pool.
+    static void *
+    operator new(std::size_t count)
+    {
+        return InstPool::get().allocate(count);
+    }
+
+    static void
+    operator delete(void *ptr, std::size_t count)
+    {
+        InstPool::get().deallocate(ptr, count);
+    }
+
     DynInstPtr inst;
     //Might want to include data about what arch. register the
     //dependence is waiting on.
@@ -132,6 +132,10 @@ DynInst::DynInst(const Arrays &arrays, const StaticInstPtr &_staticInst,
  * DynInst constructor, we also pass in a structure called "arrays" which holds
  * pointers to them. The fields of "arrays" are initialized in this operator,
  * and are then consumed in the DynInst constructor.
+ *
+ * The buffer comes from the instruction pool of the thread rather than from
+ * the heap, and is preceded by a small header recording its size so that
+ * "delete" can give it back to the right size class.
  */
 void *
 DynInst::operator new(size_t count, Arrays &arrays)
@@ -140,8 +144,11 @@ DynInst::operator new(size_t count, Arrays &arrays)
     const auto num_dests = arrays.numDests;
     const auto num_srcs = arrays.numSrcs;
 
+    static_assert(alignof(DynInst) <= InstPool::granularity,
+            "DynInst is too aligned for the instruction pool.");
+
     // Figure out where everything will go.
-    uintptr_t inst = 0;
+    uintptr_t inst = poolHeaderBytes;
     size_t inst_size = count;
 
     uintptr_t flat_dest_idx = roundUp(inst + inst_size, alignof(RegId));
@@ -167,8 +174,9 @@ DynInst::operator new(size_t count, Arrays &arrays)
     // Figure out how much space we need in total.
     size_t total_size = ready_src_idx + ready_src_idx_size;
 
-    // Actually allocate it.
-    uint8_t *buf = (uint8_t *)::operator new(total_size);
+    // Actually allocate it, and record the size in the header.
+    uint8_t *buf = (uint8_t *)InstPool::get().allocate(total_size);
+    *(size_t *)buf = total_size;
 
     // Fill in "arrays" with pointers to all the arrays.
     arrays.flatDestIdx = (RegId *)(buf + flat_dest_idx);
@@ -184,16 +192,17 @@ DynInst::operator new(size_t count, Arrays &arrays)
     new (arrays.srcIdx) PhysRegIdPtr[num_srcs];
     new (arrays.readySrcIdx) uint8_t[num_srcs];
 
-    return buf;
+    return buf + inst;
 }
 
 // Because of the custom "new" operator that allocates more bytes than the
 // size of the DynInst object, AddressSanitizer throw new-delete-type-mismatch.
-// Adding a custom delete function is enough to shut down this false positive
+// The custom delete function also returns the buffer to the pool.
 void
 DynInst::operator delete(void *ptr)
 {
-    ::operator delete(ptr);
+    uint8_t *buf = (uint8_t *)ptr - poolHeaderBytes;
+    InstPool::get().deallocate(buf, *(size_t *)buf);
 }
 
 DynInst::~DynInst()
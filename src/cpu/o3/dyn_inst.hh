@@ -80,7 +80,7 @@ class DynInst : public ExecContext, public RefCounted
 
   public:
     // The list of instructions iterator type.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef typename DynInstList::iterator ListIt;
 
     struct Arrays
     {
@@ -97,6 +97,12 @@ class DynInst : public ExecContext, public RefCounted
     static void *operator new(size_t count, Arrays &arrays);
     static void  operator delete(void* ptr);
 
+  private:
+    /** Bytes in front of each DynInst, recording its buffer size. */
+    static constexpr size_t poolHeaderBytes = InstPool::granularity;
+
+  public:
+
     /** BaseDynInst constructor given a binary instruction. */
     DynInst(const Arrays &arrays, const StaticInstPtr &staticInst,
             const StaticInstPtr &macroop, InstSeqNum seq_num, CPU *cpu);
@@ -42,7 +42,10 @@
 #ifndef __CPU_O3_DYN_INST_PTR_HH__
 #define __CPU_O3_DYN_INST_PTR_HH__
 
+#include <list>
+
 #include "base/refcnt.hh"
+#include "cpu/o3/inst_pool.hh"
 
 namespace gem5
 {
@@ -55,6 +58,9 @@ class DynInst;
 using DynInstPtr = RefCountingPtr<DynInst>;
 using DynInstConstPtr = RefCountingPtr<const DynInst>;
 
+/** List of in-flight instructions, with nodes from the instruction pool. */
+using DynInstList = std::list<DynInstPtr, InstPoolAllocator<DynInstPtr>>;
+
 } // namespace o3
 } // namespace gem5
 
@@ -770,7 +770,7 @@ Fetch::updateFetchStatus()
     while (threads != end) {
         ThreadID tid = *threads++;
 
-        if (fetchStatus[tid] == Running ||
+        if ((fetchStatus[tid] == Running && !queueStalled(tid)) ||
             fetchStatus[tid] == Squashing ||
             fetchStatus[tid] == IcacheAccessComplete) {
 
@@ -854,10 +854,10 @@ Fetch::tick()
     // Record number of instructions fetched this cycle for distribution.
     fetchStats.nisnDist.sample(numInst);
 
-    if (status_change) {
-        // Change the fetch stage status if there was a status change.
-        _status = updateFetchStatus();
-    }
+    // Update the fetch stage status. This is needed even without a change
+    // of thread status, as running threads can fill their fetch queue or
+    // have it drained by decode.
+    _status = updateFetchStatus();
 
     // Issue the next I-cache request if possible.
     for (ThreadID i = 0; i < numThreads; ++i) {
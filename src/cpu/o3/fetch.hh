@@ -319,6 +319,20 @@ class Fetch
     /** Checks if a thread is stalled. */
     bool checkStall(ThreadID tid) const;
 
+    /**
+     * Checks if a running thread can make no progress: its fetch queue is
+     * full and decode is not taking instructions. Such a thread does not
+     * keep the stage active, so the CPU can stop ticking while the back
+     * end waits on a long-latency miss. Whatever unstalls decode is
+     * activity in a later stage, which keeps the CPU ticking until fetch
+     * has seen the unblock signal.
+     */
+    bool
+    queueStalled(ThreadID tid) const
+    {
+        return stalls[tid].decode && fetchQueue[tid].size() >= fetchQueueSize;
+    }
+
     /** Updates overall fetch stage status; to be called at the end of each
      * cycle. */
     FetchStatus updateFetchStatus();
@@ -0,0 +1,154 @@
+#ifndef __CPU_O3_INST_POOL_HH__
+#define __CPU_O3_INST_POOL_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Memory pool for the objects the O3 CPU allocates for every in-flight
+ * instruction: the DynInsts themselves, the nodes of the instruction lists
+ * and the dependency graph entries. Blocks are carved out of large slabs,
+ * so instructions allocated close in time sit close in memory, and freed
+ * blocks are kept on a free list per size class rather than going back to
+ * the heap. Once the pool has grown to the peak number of in-flight
+ * instructions, allocating and freeing them costs a few instructions.
+ *
+ * There is one pool per simulation thread, so CPUs running in different
+ * event queues never contend. Slabs are never released, which also makes
+ * it safe for a block to be freed by a thread other than the one that
+ * allocated it: the block simply joins the free list of that thread.
+ */
+class InstPool
+{
+  public:
+    /** Size classes are multiples of this, which is also the alignment */
+    static constexpr std::size_t granularity = 16;
+    /** Blocks larger than this come from the heap */
+    static constexpr std::size_t maxBlockBytes = 4096;
+    static constexpr std::size_t slabBytes = 64 * 1024;
+
+    /** The pool of the calling thread */
+    static InstPool &
+    get()
+    {
+        // Deliberately never destroyed, see above
+        static thread_local InstPool *pool = new InstPool;
+        return *pool;
+    }
+
+    void *
+    allocate(std::size_t bytes)
+    {
+        std::size_t cls = sizeClass(bytes);
+        if (cls >= numClasses)
+            return ::operator new(bytes);
+
+        FreeBlock *&head = freeLists[cls];
+        if (head) {
+            FreeBlock *block = head;
+            head = block->next;
+            return block;
+        }
+
+        std::size_t block_bytes = cls * granularity;
+        if (slabUsed + block_bytes > slabBytes) {
+            slab = static_cast<char *>(::operator new(slabBytes));
+            slabUsed = 0;
+            slabs.push_back(slab);
+        }
+        void *block = slab + slabUsed;
+        slabUsed += block_bytes;
+        return block;
+    }
+
+    /** Frees a block; bytes must be the size it was allocated with */
+    void
+    deallocate(void *ptr, std::size_t bytes)
+    {
+        if (!ptr)
+            return;
+        std::size_t cls = sizeClass(bytes);
+        if (cls >= numClasses) {
+            ::operator delete(ptr);
+            return;
+        }
+        FreeBlock *block = static_cast<FreeBlock *>(ptr);
+        block->next = freeLists[cls];
+        freeLists[cls] = block;
+    }
+
+    /** Number of slabs allocated so far by this thread */
+    std::size_t numSlabs() const { return slabs.size(); }
+
+  private:
+    static constexpr std::size_t numClasses = maxBlockBytes / granularity + 1;
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    static std::size_t
+    sizeClass(std::size_t bytes)
+    {
+        // Zero-sized requests still get a distinct block
+        return bytes ? (bytes + granularity - 1) / granularity : 1;
+    }
+
+    InstPool() : freeLists(numClasses, nullptr) {}
+
+    std::vector<FreeBlock *> freeLists;
+    std::vector<char *> slabs;
+    char *slab = nullptr;
+    std::size_t slabUsed = slabBytes;
+};
+
+/**
+ * Standard allocator on top of the InstPool, used for the node-based
+ * containers of in-flight instructions. All instances are interchangeable,
+ * so lists using it can splice into each other.
+ */
+template <typename T>
+class InstPoolAllocator
+{
+  public:
+    using value_type = T;
+
+    static_assert(alignof(T) <= InstPool::granularity,
+                  "Type is too aligned for the instruction pool.");
+
+    InstPoolAllocator() = default;
+
+    template <typename U>
+    InstPoolAllocator(const InstPoolAllocator<U> &) {}
+
+    T *
+    allocate(std::size_t n)
+    {
+        return static_cast<T *>(InstPool::get().allocate(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T *ptr, std::size_t n)
+    {
+        InstPool::get().deallocate(ptr, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const InstPoolAllocator<U> &) const { return true; }
+    template <typename U>
+    bool operator!=(const InstPoolAllocator<U> &) const { return false; }
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_INST_POOL_HH__
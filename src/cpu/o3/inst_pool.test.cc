@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "cpu/o3/inst_pool.hh"
+
+using namespace gem5;
+using namespace gem5::o3;
+
+TEST(InstPoolTest, ReusesFreedBlocks)
+{
+    InstPool &pool = InstPool::get();
+    void *a = pool.allocate(200);
+    pool.deallocate(a, 200);
+    // Same size class, so the block comes back from the free list
+    void *b = pool.allocate(193);
+    EXPECT_EQ(a, b);
+    pool.deallocate(b, 193);
+}
+
+TEST(InstPoolTest, SizeClassesAreSeparate)
+{
+    InstPool &pool = InstPool::get();
+    void *small = pool.allocate(32);
+    pool.deallocate(small, 32);
+    void *large = pool.allocate(64);
+    EXPECT_NE(small, large);
+    EXPECT_EQ(pool.allocate(32), small);
+    pool.deallocate(small, 32);
+    pool.deallocate(large, 64);
+}
+
+TEST(InstPoolTest, BlocksAreAlignedAndDistinct)
+{
+    InstPool &pool = InstPool::get();
+    std::vector<void *> blocks;
+    std::set<void *> seen;
+    for (int i = 0; i < 10000; i++) {
+        std::size_t bytes = 1 + i % 500;
+        void *p = pool.allocate(bytes);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) %
+                  InstPool::granularity, 0u);
+        EXPECT_TRUE(seen.insert(p).second);
+        // Touch the whole block
+        std::fill_n(static_cast<char *>(p), bytes, char(i));
+        blocks.push_back(p);
+    }
+    for (int i = 0; i < 10000; i++)
+        pool.deallocate(blocks[i], 1 + i % 500);
+}
+
+TEST(InstPoolTest, LargeBlocksUseHeap)
+{
+    InstPool &pool = InstPool::get();
+    std::size_t slabs = pool.numSlabs();
+    void *p = pool.allocate(InstPool::maxBlockBytes * 4);
+    EXPECT_EQ(pool.numSlabs(), slabs);
+    pool.deallocate(p, InstPool::maxBlockBytes * 4);
+}
+
+TEST(InstPoolTest, PeakBoundsSlabs)
+{
+    InstPool &pool = InstPool::get();
+    std::vector<void *> blocks(1000);
+    for (auto &b : blocks)
+        b = pool.allocate(256);
+    for (auto b : blocks)
+        pool.deallocate(b, 256);
+    std::size_t slabs = pool.numSlabs();
+
+    // Cycling through the same peak allocates no more slabs
+    for (int it = 0; it < 100; it++) {
+        for (auto &b : blocks)
+            b = pool.allocate(256);
+        for (auto b : blocks)
+            pool.deallocate(b, 256);
+    }
+    EXPECT_EQ(pool.numSlabs(), slabs);
+}
+
+TEST(InstPoolTest, ListAllocator)
+{
+    using List = std::list<std::shared_ptr<int>,
+                           InstPoolAllocator<std::shared_ptr<int>>>;
+    auto val = std::make_shared<int>(0);
+    List a, b;
+    for (int i = 0; i < 100; i++)
+        a.push_back(val);
+    for (int i = 0; i < 50; i++)
+        b.push_back(val);
+    EXPECT_EQ(val.use_count(), 151);
+
+    // Allocators compare equal, so splicing moves nodes between lists
+    b.splice(b.end(), a, a.begin(), std::next(a.begin(), 25));
+    EXPECT_EQ(a.size(), 75u);
+    EXPECT_EQ(b.size(), 75u);
+
+    a.clear();
+    b.erase(b.begin(), std::next(b.begin(), 70));
+    EXPECT_EQ(val.use_count(), 6);
+    b.clear();
+    EXPECT_EQ(val.use_count(), 1);
+}
+
+// Alloc/free pattern of the O3 instruction lists: a window of in-flight
+// entries where the oldest is retired as a new one is fetched. Compares
+// against the default allocator. Disabled by default; run with
+// --gtest_also_run_disabled_tests.
+TEST(InstPoolTest, DISABLED_InstWindowThroughput)
+{
+    constexpr int window = 192;
+    constexpr int iters = 1 << 24;
+
+    using Clock = std::chrono::steady_clock;
+    auto run = [&](auto &list) {
+        for (int i = 0; i < window; i++)
+            list.push_back(i);
+        auto start = Clock::now();
+        for (int i = 0; i < iters; i++) {
+            list.pop_front();
+            list.push_back(i);
+        }
+        std::chrono::duration<double> secs = Clock::now() - start;
+        return iters / secs.count();
+    };
+
+    std::list<std::uint64_t> std_list;
+    double std_rate = run(std_list);
+    std::list<std::uint64_t, InstPoolAllocator<std::uint64_t>> pool_list;
+    double pool_rate = run(pool_list);
+
+    std::cout << "std::allocator:    " << std_rate << " insts/s\n"
+              << "InstPoolAllocator: " << pool_rate << " insts/s\n";
+    EXPECT_EQ(std_list.size(), pool_list.size());
+}
@@ -72,7 +72,7 @@ class ROB
 {
   public:
     typedef std::pair<RegIndex, RegIndex> UnmapInfo;
-    typedef typename std::list<DynInstPtr>::iterator InstIt;
+    typedef typename DynInstList::iterator InstIt;
 
     /** Possible ROB statuses. */
     enum Status
@@ -286,7 +286,7 @@ class ROB
     unsigned maxEntries[MaxThreads];
 
     /** ROB List of Instructions */
-    std::list<DynInstPtr> instList[MaxThreads];
+    DynInstList instList[MaxThreads];
 
     /** Number of instructions that can be squashed in a single cycle. */
     unsigned squashWidth;
@@ -0,0 +1,47 @@
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+
+class DistCXLLink(SimObject):
+    """Carries CXL.mem transactions between the gem5 processes of a dist
+    run. A host process connects the cpu_side_port of its link to, e.g.,
+    its CXLBridge. The pool process, which plays the role of the switch,
+    has a link per host, in order of their ranks, and connects their
+    mem_side_ports to the pooled memory."""
+
+    type = "DistCXLLink"
+    cxx_header = "dev/net/dist_cxl_link.hh"
+    cxx_class = "gem5::DistCXLLink"
+
+    cpu_side_port = ResponsePort(
+        "Host side: receives requests to the pool and sends responses"
+    )
+    mem_side_port = RequestPort(
+        "Pool side: sends the requests of the host to the pool"
+    )
+
+    system = Param.System(Parent.any, "System this link is part of")
+    ranges = VectorParam.AddrRange(
+        [], "Host side: address ranges of the pooled memory"
+    )
+    max_outstanding = Param.Unsigned(
+        64, "Host side: requests waiting for a response from the pool"
+    )
+
+    delay = Param.Latency(
+        "1us", "link delay, at least as long as the sync quantum"
+    )
+    speed = Param.MemoryBandwidth("64GiB/s", "link bandwidth")
+    dist_rank = Param.UInt32("0", "Rank of this gem5 process (dist run)")
+    dist_size = Param.UInt32("1", "Number of gem5 processes (dist run)")
+    sync_start = Param.Latency("5200000000000t", "first dist sync barrier")
+    sync_repeat = Param.Latency("0us", "dist sync barrier repeat, or delay")
+    server_name = Param.String("localhost", "Message server name")
+    server_port = Param.UInt32("2200", "Message server port")
+    is_switch = Param.Bool(False, "true if this is a link of the pool process")
+    dist_sync_on_pseudo_op = Param.Bool(False, "Start sync with pseudo_op")
+    num_nodes = Param.UInt32("2", "Number of simulated nodes")
+    transport = Param.DistTransport(
+        "tcp", "Connection to the peers, shm if all are on this host"
+    )
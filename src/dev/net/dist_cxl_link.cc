@@ -0,0 +1,334 @@
+#include "dev/net/dist_cxl_link.hh"
+
+#include <cmath>
+#include <cstring>
+
+#include "base/cast.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/DistCXL.hh"
+#include "debug/Drain.hh"
+#include "dev/net/dist_iface.hh"
+#include "dev/net/shm_iface.hh"
+#include "dev/net/tcp_iface.hh"
+#include "sim/cur_tick.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+DistCXLLink::DistCXLLink(const Params &p)
+    : SimObject(p),
+      cpuSidePort(name() + ".cpu_side_port", *this),
+      memSidePort(name() + ".mem_side_port", *this),
+      ranges(p.ranges.begin(), p.ranges.end()),
+      requestorId(p.system->getRequestorId(this)),
+      linkDelay(p.delay), ticksPerByte(p.speed),
+      maxOutstanding(p.max_outstanding), isSwitch(p.is_switch),
+      txFreeAt(0), txEvent([this]{ transmit(); }, name() + ".txEvent"),
+      nextId(0), retryReq(false), waitingForRespRetry(false),
+      waitingForReqRetry(false), inMemory(0),
+      rxDoneEvent([this]{ rxDone(); }, name() + ".rxDoneEvent")
+{
+    Tick sync_repeat = p.sync_repeat != 0 ? p.sync_repeat : p.delay;
+    // Messages sent in a quantum must not arrive before its end
+    fatal_if(p.delay < sync_repeat, "%s: the link delay (%lu) must not be "
+             "shorter than sync_repeat (%lu)", name(), p.delay, sync_repeat);
+
+    // create the dist interface to talk to the peer gem5 processes.
+    if (p.transport == enums::shm) {
+        distIface = new ShmIface(p.server_port, p.dist_rank, p.dist_size,
+                                 p.sync_start, sync_repeat, this,
+                                 p.dist_sync_on_pseudo_op, p.is_switch,
+                                 p.num_nodes);
+    } else {
+        distIface = new TCPIface(p.server_name, p.server_port,
+                                 p.dist_rank, p.dist_size,
+                                 p.sync_start, sync_repeat, this,
+                                 p.dist_sync_on_pseudo_op, p.is_switch,
+                                 p.num_nodes);
+    }
+}
+
+DistCXLLink::~DistCXLLink()
+{
+    delete distIface;
+}
+
+Port &
+DistCXLLink::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "cpu_side_port")
+        return cpuSidePort;
+    else if (if_name == "mem_side_port")
+        return memSidePort;
+    return SimObject::getPort(if_name, idx);
+}
+
+void
+DistCXLLink::init()
+{
+    DPRINTF(DistCXL, "DistCXLLink::init() called\n");
+    if (isSwitch) {
+        fatal_if(!memSidePort.isConnected(), "%s: the pool side of the "
+                 "link needs its mem_side_port connected", name());
+    } else {
+        fatal_if(!cpuSidePort.isConnected(), "%s: the host side of the "
+                 "link needs its cpu_side_port connected", name());
+        cpuSidePort.sendRangeChange();
+    }
+    distIface->init(&rxDoneEvent, linkDelay);
+}
+
+void
+DistCXLLink::startup()
+{
+    DPRINTF(DistCXL, "DistCXLLink::startup() called\n");
+    distIface->startup();
+}
+
+bool
+DistCXLLink::recvTimingReq(PacketPtr pkt)
+{
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    bool needs_response = pkt->needsResponse();
+    if (needs_response && outstanding.size() >= maxOutstanding) {
+        DPRINTF(DistCXL, "Too many outstanding requests, refusing %s\n",
+                pkt->print());
+        retryReq = true;
+        return false;
+    }
+
+    MsgHeader header = {};
+    header.id = nextId++;
+    header.addr = pkt->getAddr();
+    header.flags = pkt->req->getFlags();
+    header.size = pkt->getSize();
+    header.cmd = pkt->cmd.toInt();
+    header.hasData = pkt->hasData();
+    sendMessage(header, pkt);
+
+    if (needs_response)
+        outstanding[header.id] = pkt;
+    else
+        pendingDelete.reset(pkt);
+    return true;
+}
+
+bool
+DistCXLLink::recvTimingResp(PacketPtr pkt)
+{
+    auto state = safe_cast<LinkSenderState *>(pkt->popSenderState());
+
+    MsgHeader header = {};
+    header.id = state->id;
+    header.addr = pkt->getAddr();
+    header.size = pkt->getSize();
+    header.cmd = pkt->cmd.toInt();
+    header.hasData = pkt->hasData();
+    sendMessage(header, pkt);
+
+    delete state;
+    delete pkt;
+
+    assert(inMemory > 0);
+    inMemory--;
+    checkDrain();
+    return true;
+}
+
+void
+DistCXLLink::trySendRequests()
+{
+    while (!reqQueue.empty() && !waitingForReqRetry) {
+        PacketPtr pkt = reqQueue.front();
+        // The packet may be gone once sent if it needs no response
+        bool needs_response = pkt->needsResponse();
+        if (!memSidePort.sendTimingReq(pkt)) {
+            waitingForReqRetry = true;
+            return;
+        }
+        reqQueue.pop_front();
+        if (needs_response)
+            inMemory++;
+    }
+    checkDrain();
+}
+
+void
+DistCXLLink::trySendResponses()
+{
+    while (!respQueue.empty() && !waitingForRespRetry) {
+        if (!cpuSidePort.sendTimingResp(respQueue.front())) {
+            waitingForRespRetry = true;
+            return;
+        }
+        respQueue.pop_front();
+    }
+    checkDrain();
+}
+
+void
+DistCXLLink::MemSidePort::recvReqRetry()
+{
+    link.waitingForReqRetry = false;
+    link.trySendRequests();
+}
+
+void
+DistCXLLink::CPUSidePort::recvRespRetry()
+{
+    link.waitingForRespRetry = false;
+    link.trySendResponses();
+}
+
+Tick
+DistCXLLink::CPUSidePort::recvAtomic(PacketPtr pkt)
+{
+    panic("%s: only timing accesses can cross the link, not %s",
+          name(), pkt->print());
+}
+
+void
+DistCXLLink::CPUSidePort::recvFunctional(PacketPtr pkt)
+{
+    panic("%s: the memory behind the link is in another process, "
+          "functional %s cannot reach it", name(), pkt->print());
+}
+
+void
+DistCXLLink::sendMessage(const MsgHeader &header, PacketPtr pkt)
+{
+    DPRINTF(DistCXL, "Sending %s id:%llu addr:%#x size:%d\n",
+            MemCmd(MemCmd::Command(header.cmd)).toString(), header.id,
+            header.addr, header.size);
+
+    unsigned data_size = header.hasData ? header.size : 0;
+    auto msg = std::make_shared<EthPacketData>(sizeof(header) + data_size);
+    std::memcpy(msg->data, &header, sizeof(header));
+    if (data_size)
+        pkt->writeData(msg->data + sizeof(header));
+    msg->length = sizeof(header) + data_size;
+    msg->simLength = msg->length;
+
+    txQueue.push_back(msg);
+    if (!txEvent.scheduled())
+        schedule(txEvent, std::max(curTick(), txFreeAt));
+}
+
+void
+DistCXLLink::transmit()
+{
+    assert(!txQueue.empty());
+    EthPacketPtr msg = txQueue.front();
+    txQueue.pop_front();
+
+    // The receiver expects a message not to start before the previous
+    // one is done, so the messages are serialized here
+    Tick delay = (Tick)ceil(((double)msg->simLength * ticksPerByte) + 1.0);
+    distIface->packetOut(msg, delay);
+    txFreeAt = curTick() + delay;
+
+    if (!txQueue.empty())
+        schedule(txEvent, txFreeAt);
+    else
+        checkDrain();
+}
+
+void
+DistCXLLink::rxDone()
+{
+    EthPacketPtr msg = distIface->packetIn();
+    panic_if(msg->length < sizeof(MsgHeader), "%s: message too short (%d "
+             "bytes)", name(), msg->length);
+
+    MsgHeader header;
+    std::memcpy(&header, msg->data, sizeof(header));
+    const uint8_t *data = msg->data + sizeof(header);
+    MemCmd cmd(MemCmd::Command(header.cmd));
+    panic_if(header.hasData && msg->length < sizeof(header) + header.size,
+             "%s: %s message without its data", name(), cmd.toString());
+
+    DPRINTF(DistCXL, "Received %s id:%llu addr:%#x size:%d\n",
+            cmd.toString(), header.id, header.addr, header.size);
+
+    if (isSwitch) {
+        RequestPtr req = std::make_shared<Request>(header.addr, header.size,
+                                                   header.flags, requestorId);
+        PacketPtr pkt = new Packet(req, cmd);
+        pkt->allocate();
+        if (header.hasData)
+            pkt->setData(data);
+        if (pkt->needsResponse())
+            pkt->pushSenderState(new LinkSenderState(header.id));
+
+        reqQueue.push_back(pkt);
+        trySendRequests();
+    } else {
+        auto it = outstanding.find(header.id);
+        panic_if(it == outstanding.end(), "%s: response to unknown "
+                 "request %llu", name(), header.id);
+        PacketPtr pkt = it->second;
+        outstanding.erase(it);
+
+        pkt->makeResponse();
+        pkt->headerDelay = pkt->payloadDelay = 0;
+        if (cmd.isError())
+            pkt->setBadAddress();
+        else if (header.hasData)
+            pkt->setData(data);
+
+        respQueue.push_back(pkt);
+        trySendResponses();
+
+        if (retryReq) {
+            retryReq = false;
+            cpuSidePort.sendRetryReq();
+        }
+    }
+}
+
+bool
+DistCXLLink::busy() const
+{
+    return !txQueue.empty() || !outstanding.empty() || !respQueue.empty() ||
+        !reqQueue.empty() || inMemory > 0;
+}
+
+void
+DistCXLLink::checkDrain()
+{
+    if (drainState() == DrainState::Draining && !busy()) {
+        DPRINTF(Drain, "DistCXLLink done draining\n");
+        signalDrainDone();
+    }
+}
+
+DrainState
+DistCXLLink::drain()
+{
+    // Packets cannot be checkpointed, so wait for the transactions in
+    // flight; messages already handed to the dist interface are saved
+    // by it
+    return busy() ? DrainState::Draining : DrainState::Drained;
+}
+
+void
+DistCXLLink::serialize(CheckpointOut &cp) const
+{
+    distIface->serializeSection(cp, "distIface");
+    SERIALIZE_SCALAR(txFreeAt);
+    SERIALIZE_SCALAR(nextId);
+}
+
+void
+DistCXLLink::unserialize(CheckpointIn &cp)
+{
+    distIface->unserializeSection(cp, "distIface");
+    UNSERIALIZE_SCALAR(txFreeAt);
+    UNSERIALIZE_SCALAR(nextId);
+}
+
+} // namespace gem5
@@ -0,0 +1,204 @@
+/* @file
+ * Link carrying CXL.mem transactions between gem5 processes of a dist
+ * run.
+ *
+ * See comments in dev/net/dist_iface.hh for a generic description of dist
+ * gem5 simulations.
+ *
+ * The link uses the same interface, synchronization and checkpointing as
+ * DistEtherLink, but the payload of its messages is a memory transaction
+ * instead of an Ethernet frame. Each gem5 process simulating a host has
+ * a link with is_switch unset, its cpu_side_port takes the requests of
+ * the host to the pooled memory, e.g., from a CXLBridge. The process
+ * simulating the memory pool plays the role of the switch: it has one
+ * link per host, in order of the rank of the hosts, and their
+ * mem_side_ports send the requests on to the pool, e.g., a CXLMemBar in
+ * front of a CXLMemory.
+ *
+ * Only timing accesses can cross the link. As for Ethernet, the link delay
+ * must be at least as long as the sync quantum.
+ */
+
+#ifndef __DEV_DIST_CXL_LINK_HH__
+#define __DEV_DIST_CXL_LINK_HH__
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+#include "base/addr_range.hh"
+#include "base/types.hh"
+#include "dev/net/etherpkt.hh"
+#include "mem/packet.hh"
+#include "mem/port.hh"
+#include "params/DistCXLLink.hh"
+#include "sim/eventq.hh"
+#include "sim/serialize.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class DistIface;
+
+class DistCXLLink : public SimObject
+{
+  protected:
+    /**
+     * Header in front of every message on the link, followed by the data
+     * of the transaction if hasData is set.
+     */
+    struct MsgHeader
+    {
+        /** Id of the request, echoed in its response */
+        uint64_t id;
+        Addr addr;
+        Request::FlagsType flags;
+        uint32_t size;
+        /** MemCmd::Command of the request or response */
+        uint16_t cmd;
+        uint16_t hasData;
+    };
+
+    /** Remembers the id of a request the pool side sent to memory */
+    struct LinkSenderState : public Packet::SenderState
+    {
+        const uint64_t id;
+        LinkSenderState(uint64_t _id) : id(_id) {}
+    };
+
+    class CPUSidePort : public ResponsePort
+    {
+      protected:
+        DistCXLLink &link;
+
+      public:
+        CPUSidePort(const std::string &_name, DistCXLLink &_link)
+            : ResponsePort(_name), link(_link) {}
+
+      protected:
+        bool
+        recvTimingReq(PacketPtr pkt) override
+        {
+            return link.recvTimingReq(pkt);
+        }
+
+        Tick recvAtomic(PacketPtr pkt) override;
+        void recvFunctional(PacketPtr pkt) override;
+        void recvRespRetry() override;
+
+        AddrRangeList
+        getAddrRanges() const override
+        {
+            return link.ranges;
+        }
+    };
+
+    class MemSidePort : public RequestPort
+    {
+      protected:
+        DistCXLLink &link;
+
+      public:
+        MemSidePort(const std::string &_name, DistCXLLink &_link)
+            : RequestPort(_name), link(_link) {}
+
+      protected:
+        bool
+        recvTimingResp(PacketPtr pkt) override
+        {
+            return link.recvTimingResp(pkt);
+        }
+
+        void recvReqRetry() override;
+        void recvRangeChange() override {}
+    };
+
+    CPUSidePort cpuSidePort;
+    MemSidePort memSidePort;
+
+    /** Address ranges of the pool, as seen by the host */
+    const AddrRangeList ranges;
+
+    const RequestorID requestorId;
+
+    /** Link delay, the minimum time a message takes to the peer */
+    const Tick linkDelay;
+    /** Per byte send delay */
+    const double ticksPerByte;
+    /** Requests of the host the pool has not responded to yet */
+    const unsigned maxOutstanding;
+
+    /** Is this the pool side of the link? */
+    const bool isSwitch;
+
+    /** The dist (TCP) interface to the peer gem5 process */
+    DistIface *distIface;
+
+    /** Messages are sent one after the other, as the link is free */
+    std::deque<EthPacketPtr> txQueue;
+    Tick txFreeAt;
+    EventFunctionWrapper txEvent;
+
+    uint64_t nextId;
+
+    /** Host side: requests waiting for their response, by id */
+    std::unordered_map<uint64_t, PacketPtr> outstanding;
+    /** Host side: a request was refused and the host waits for a retry */
+    bool retryReq;
+
+    /** Host side: responses the cpu side port did not take yet */
+    std::deque<PacketPtr> respQueue;
+    bool waitingForRespRetry;
+
+    /** Pool side: requests the mem side port did not take yet */
+    std::deque<PacketPtr> reqQueue;
+    bool waitingForReqRetry;
+    /** Pool side: requests sent to memory and waiting for a response */
+    unsigned inMemory;
+
+    /** Host side requests without response are deleted once sent */
+    std::unique_ptr<Packet> pendingDelete;
+
+    EventFunctionWrapper rxDoneEvent;
+
+    bool recvTimingReq(PacketPtr pkt);
+    bool recvTimingResp(PacketPtr pkt);
+
+    void trySendRequests();
+    void trySendResponses();
+
+    /** Queue a message, followed by the data of the packet if the
+     *  header says it has data */
+    void sendMessage(const MsgHeader &header, PacketPtr pkt);
+    /** Hand the first queued message to the dist interface */
+    void transmit();
+
+    /** A message from the peer arrived */
+    void rxDone();
+
+    /** Is a transaction still in flight in this process? */
+    bool busy() const;
+    /** Finish draining once the last transaction is done */
+    void checkDrain();
+
+  public:
+    PARAMS(DistCXLLink);
+    DistCXLLink(const Params &p);
+    ~DistCXLLink();
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    void init() override;
+    void startup() override;
+
+    DrainState drain() override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+};
+
+} // namespace gem5
+
+#endif // __DEV_DIST_CXL_LINK_HH__
@@ -60,6 +60,7 @@
 #include "dev/net/etherint.hh"
 #include "dev/net/etherlink.hh"
 #include "dev/net/etherpkt.hh"
+#include "dev/net/shm_iface.hh"
 #include "dev/net/tcp_iface.hh"
 #include "params/EtherLink.hh"
 #include "sim/cur_tick.hh"
@@ -89,12 +90,19 @@ DistEtherLink::DistEtherLink(const Params &p)
         sync_repeat = p.delay;
     }
 
-    // create the dist (TCP) interface to talk to the peer gem5 processes.
-    distIface = new TCPIface(p.server_name, p.server_port,
-                             p.dist_rank, p.dist_size,
-                             p.sync_start, sync_repeat, this,
-                             p.dist_sync_on_pseudo_op, p.is_switch,
-                             p.num_nodes);
+    // create the dist interface to talk to the peer gem5 processes.
+    if (p.transport == enums::shm) {
+        distIface = new ShmIface(p.server_port, p.dist_rank, p.dist_size,
+                                 p.sync_start, sync_repeat, this,
+                                 p.dist_sync_on_pseudo_op, p.is_switch,
+                                 p.num_nodes);
+    } else {
+        distIface = new TCPIface(p.server_name, p.server_port,
+                                 p.dist_rank, p.dist_size,
+                                 p.sync_start, sync_repeat, this,
+                                 p.dist_sync_on_pseudo_op, p.is_switch,
+                                 p.num_nodes);
+    }
 
     localIface = new LocalIface(name() + ".int0", txLink, rxLink, distIface);
 }
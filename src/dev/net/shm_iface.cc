@@ -0,0 +1,365 @@
+#include "dev/net/shm_iface.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <thread>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/DistEthernet.hh"
+#include "debug/DistEthernetCmd.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** Sleep until the word is no longer value, or for a while */
+void
+futexWait(std::atomic<uint32_t> &word, uint32_t value)
+{
+#if defined(__linux__)
+    // The timeout lets the waiter notice a peer that died
+    struct timespec timeout = { 0, 100 * 1000 * 1000 };
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT,
+            value, &timeout, nullptr, 0);
+#else
+    if (word.load() == value)
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+#endif
+}
+
+void
+futexWake(std::atomic<uint32_t> &word)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE,
+            INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+bool
+processGone(pid_t pid)
+{
+    return pid != 0 && kill(pid, 0) != 0 && errno == ESRCH;
+}
+
+} // anonymous namespace
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+              std::atomic<uint32_t>::is_always_lock_free,
+              "Shared memory channels need lock free atomics");
+
+std::vector<ShmIface *> ShmIface::ifaceRegistry;
+
+ShmIface::ShmIface(unsigned server_port, unsigned dist_rank,
+                   unsigned dist_size, Tick sync_start, Tick sync_repeat,
+                   EventManager *em, bool use_pseudo_op, bool is_switch,
+                   int num_nodes) :
+    DistIface(dist_rank, dist_size, sync_start, sync_repeat, em, use_pseudo_op,
+              is_switch, num_nodes),
+    channel(nullptr), out(nullptr), in(nullptr), peerPid(0),
+    serverPort(server_port), isSwitch(is_switch)
+{
+    // The nodes create the channels, so there is nothing to set up here.
+    // The message tells the launch scripts that the nodes may start.
+    if (is_switch && isPrimary)
+        inform("shm_iface listening on port %d", serverPort);
+}
+
+ShmIface::~ShmIface()
+{
+    if (!channel)
+        return;
+    // Let the receiver threads on both sides go. The mapping is kept, the
+    // receiver thread of this link is only joined after this destructor.
+    channel->closed.store(1);
+    notify(in->written);
+    notify(in->read);
+    notify(out->written);
+    notify(out->read);
+}
+
+std::string
+ShmIface::channelName(int port, unsigned rank, unsigned id)
+{
+    return csprintf("/gem5-dist-%d-%u-%u", port, rank, id);
+}
+
+bool
+ShmIface::peerGone() const
+{
+    return channel->closed.load() || processGone(peerPid);
+}
+
+template <typename Cond>
+bool
+ShmIface::waitFor(Wakeup &wakeup, Cond cond) const
+{
+    for (unsigned i = 0; i < spinLimit; i++) {
+        if (cond())
+            return true;
+        // Let the peer run if it shares the core with us
+        if (i % 64 == 63)
+            std::this_thread::yield();
+    }
+
+    for (;;) {
+        uint32_t seq = wakeup.seq.load();
+        // The notifier checks waiting after bumping seq, so either it sees
+        // the flag or we see the progress it made
+        wakeup.waiting.store(1);
+        if (cond()) {
+            wakeup.waiting.store(0);
+            return true;
+        }
+        futexWait(wakeup.seq, seq);
+        wakeup.waiting.store(0);
+        if (cond())
+            return true;
+        if (peerGone())
+            return false;
+    }
+}
+
+void
+ShmIface::notify(Wakeup &wakeup)
+{
+    wakeup.seq.fetch_add(1);
+    if (wakeup.waiting.load())
+        futexWake(wakeup.seq);
+}
+
+bool
+ShmIface::writeRing(Ring &ring, const void *buf, uint64_t length)
+{
+    auto src = static_cast<const uint8_t *>(buf);
+    while (length > 0) {
+        uint64_t head = ring.head.load(std::memory_order_relaxed);
+        if (!waitFor(ring.read, [&ring, head] {
+                return head - ring.tail.load() < Ring::capacity;
+            })) {
+            return false;
+        }
+
+        uint64_t space = Ring::capacity - (head - ring.tail.load());
+        uint64_t n = std::min(length, space);
+        uint64_t offset = head % Ring::capacity;
+        uint64_t first = std::min(n, Ring::capacity - offset);
+        std::memcpy(ring.data + offset, src, first);
+        std::memcpy(ring.data, src + first, n - first);
+        ring.head.store(head + n);
+        notify(ring.written);
+
+        src += n;
+        length -= n;
+    }
+    return true;
+}
+
+bool
+ShmIface::readRing(Ring &ring, void *buf, uint64_t length)
+{
+    auto dst = static_cast<uint8_t *>(buf);
+    while (length > 0) {
+        uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+        if (!waitFor(ring.written, [&ring, tail] {
+                return ring.head.load() != tail;
+            })) {
+            return false;
+        }
+
+        uint64_t n = std::min(length, ring.head.load() - tail);
+        uint64_t offset = tail % Ring::capacity;
+        uint64_t first = std::min(n, Ring::capacity - offset);
+        std::memcpy(dst, ring.data + offset, first);
+        std::memcpy(dst + first, ring.data, n - first);
+        ring.tail.store(tail + n);
+        notify(ring.read);
+
+        dst += n;
+        length -= n;
+    }
+    return true;
+}
+
+void
+ShmIface::send(const void *buf, unsigned length)
+{
+    if (!writeRing(*out, buf, length)) {
+        exitSimLoop("Message server closed connection, simulation "
+                    "is exiting");
+    }
+}
+
+void
+ShmIface::establishConnection()
+{
+    static unsigned cur_rank = 0;
+    static unsigned cur_id = 0;
+
+    if (isSwitch) {
+        // Channels are taken in the same order as the TCP connections, so
+        // every node link is always connected to the same switch port
+        std::string name = channelName(serverPort, cur_rank, cur_id);
+        DPRINTF(DistEthernet, "Waiting for channel %s\n", name);
+        for (;;) {
+            int fd = shm_open(name.c_str(), O_RDWR, 0);
+            if (fd < 0) {
+                panic_if(errno != ENOENT, "shm_open(%s) failed: %s", name,
+                         strerror(errno));
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            struct stat st;
+            if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Channel)) {
+                // The node did not finish creating it
+                close(fd);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            void *addr = mmap(nullptr, sizeof(Channel),
+                              PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            panic_if(addr == MAP_FAILED, "mmap(%s) failed: %s", name,
+                     strerror(errno));
+            close(fd);
+            channel = static_cast<Channel *>(addr);
+
+            uint32_t state;
+            while ((state = channel->state.load()) == created)
+                futexWait(channel->state, state);
+            if (state == ready && !processGone(channel->nodePid))
+                break;
+
+            // Left behind by a run that did not finish connecting
+            warn("Removing stale channel %s", name);
+            munmap(channel, sizeof(Channel));
+            channel = nullptr;
+            shm_unlink(name.c_str());
+        }
+        assert(channel->rank == cur_rank);
+        assert(channel->distIfaceId == cur_id);
+        // Nobody else opens the channel, it goes away with the processes
+        shm_unlink(name.c_str());
+
+        inform("Link okay  (iface:%d -> (node:%d, iface:%d))",
+               distIfaceId, channel->rank, channel->distIfaceId);
+        if (channel->distIfaceId < channel->distIfaceNum - 1) {
+            cur_id++;
+        } else {
+            cur_rank++;
+            cur_id = 0;
+        }
+
+        out = &channel->toNode;
+        in = &channel->toSwitch;
+        peerPid = channel->nodePid;
+        channel->switchPid = getpid();
+        channel->state.store(connected);
+        futexWake(channel->state);
+    } else {
+        std::string name = channelName(serverPort, rank, distIfaceId);
+        shm_unlink(name.c_str());
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        panic_if(fd < 0, "shm_open(%s) failed: %s", name, strerror(errno));
+        panic_if(ftruncate(fd, sizeof(Channel)) != 0,
+                 "ftruncate(%s) failed: %s", name, strerror(errno));
+        void *addr = mmap(nullptr, sizeof(Channel), PROT_READ | PROT_WRITE,
+                          MAP_SHARED, fd, 0);
+        panic_if(addr == MAP_FAILED, "mmap(%s) failed: %s", name,
+                 strerror(errno));
+        close(fd);
+
+        channel = new (addr) Channel();
+        channel->rank = rank;
+        channel->distIfaceId = distIfaceId;
+        channel->distIfaceNum = distIfaceNum;
+        channel->nodePid = getpid();
+        out = &channel->toSwitch;
+        in = &channel->toNode;
+
+        channel->state.store(ready);
+        futexWake(channel->state);
+        DPRINTF(DistEthernet, "Created channel %s, waiting for ack "
+                "(distIfaceId:%d)\n", name, distIfaceId);
+
+        uint32_t state;
+        while ((state = channel->state.load()) != connected)
+            futexWait(channel->state, state);
+        peerPid = channel->switchPid;
+        inform("Link okay  (iface:%d -> switch)", distIfaceId);
+    }
+    ifaceRegistry.push_back(this);
+}
+
+void
+ShmIface::sendPacket(const Header &header, const EthPacketPtr &packet)
+{
+    std::lock_guard<std::mutex> lock(sendLock);
+    send(&header, sizeof(header));
+    send(packet->data, packet->length);
+}
+
+void
+ShmIface::sendCmd(const Header &header)
+{
+    DPRINTF(DistEthernetCmd, "ShmIface::sendCmd() type: %d\n",
+            static_cast<int>(header.msgType));
+    // Global commands (i.e. sync request) are always sent by the primary
+    // DistIface, as point-to-point messages on every channel
+    for (auto iface: ifaceRegistry) {
+        std::lock_guard<std::mutex> lock(iface->sendLock);
+        iface->send(&header, sizeof(header));
+    }
+}
+
+bool
+ShmIface::recvHeader(Header &header)
+{
+    bool ret = readRing(*in, &header, sizeof(header));
+    if (!ret)
+        inform("recv(): Connection closed");
+    DPRINTF(DistEthernetCmd, "ShmIface::recvHeader() type: %d ret: %d\n",
+            static_cast<int>(header.msgType), ret);
+    return ret;
+}
+
+void
+ShmIface::recvPacket(const Header &header, EthPacketPtr &packet)
+{
+    packet = std::make_shared<EthPacketData>(header.dataPacketLength);
+    bool ret = readRing(*in, packet->data, header.dataPacketLength);
+    panic_if(!ret, "Error while reading channel");
+    packet->simLength = header.simLength;
+    packet->length = header.dataPacketLength;
+}
+
+void
+ShmIface::initTransport()
+{
+    // As for TCP, the channels are set up once the number of dist
+    // interfaces of each process is known
+    establishConnection();
+}
+
+} // namespace gem5
@@ -0,0 +1,165 @@
+/* @file
+ * Shared memory interface for dist-gem5 simulations.
+ *
+ * For a high level description about dist-gem5 see comments in
+ * header file dist_iface.hh.
+ *
+ * This is a drop in replacement for TCPIface when all the gem5 processes
+ * of a dist run are on the same host. Each link has a shared memory
+ * channel to the server process (the one simulating the switch) instead
+ * of a stream socket. A channel holds a ring buffer for each direction,
+ * the receiver spins for a while on an empty ring and then sleeps on a
+ * futex until the sender wakes it up, so messages and sync barriers do
+ * not go through the kernel while the peers are busy.
+ *
+ * The channels are named after the server port and the rank and id of the
+ * node link, so the server port must be unique among the dist runs of a
+ * host. All the links of a dist run must use the same transport.
+ */
+#ifndef __DEV_NET_SHM_IFACE_HH__
+#define __DEV_NET_SHM_IFACE_HH__
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dev/net/dist_iface.hh"
+
+namespace gem5
+{
+
+class EventManager;
+
+class ShmIface : public DistIface
+{
+  private:
+    /**
+     * A futex word the waiting side sleeps on, bumped by the side that
+     * makes progress.
+     */
+    struct Wakeup
+    {
+        std::atomic<uint32_t> seq;
+        std::atomic<uint32_t> waiting;
+    };
+
+    /**
+     * One direction of a channel, a byte stream like a TCP socket.
+     */
+    struct Ring
+    {
+        static constexpr uint64_t capacity = 1 << 20;
+
+        /** Bytes written so far, only the writer changes it */
+        alignas(64) std::atomic<uint64_t> head;
+        Wakeup written;
+        /** Bytes read so far, only the reader changes it */
+        alignas(64) std::atomic<uint64_t> tail;
+        Wakeup read;
+
+        alignas(64) uint8_t data[capacity];
+    };
+
+    enum ChannelState : uint32_t
+    {
+        created = 0,
+        /** The node filled in its link info */
+        ready,
+        /** The server took the link */
+        connected,
+    };
+
+    /**
+     * The shared memory between a node link and its server link.
+     */
+    struct Channel
+    {
+        std::atomic<uint32_t> state;
+        /** Set by the first side going away */
+        std::atomic<uint32_t> closed;
+        unsigned rank;
+        unsigned distIfaceId;
+        unsigned distIfaceNum;
+        pid_t nodePid;
+        pid_t switchPid;
+
+        Ring toSwitch;
+        Ring toNode;
+    };
+
+    Channel *channel;
+    Ring *out;
+    Ring *in;
+    pid_t peerPid;
+
+    /** Serializes the messages of the senders of this link */
+    std::mutex sendLock;
+
+    int serverPort;
+    bool isSwitch;
+
+    /**
+     * Storage for all open channels, the sync commands go to all of them
+     */
+    static std::vector<ShmIface *> ifaceRegistry;
+
+    /**
+     * Polls before a waiting side sleeps, a sleeping receiver takes a few
+     * microseconds to wake up. The core is yielded now and then while
+     * polling, as peers may share it.
+     */
+    static constexpr unsigned spinLimit = 20000;
+
+  private:
+    static std::string channelName(int port, unsigned rank, unsigned id);
+
+    /** Is the other end of the channel gone? */
+    bool peerGone() const;
+
+    /** Wait until cond() holds, false if the peer went away meanwhile */
+    template <typename Cond>
+    bool waitFor(Wakeup &wakeup, Cond cond) const;
+    static void notify(Wakeup &wakeup);
+
+    bool writeRing(Ring &ring, const void *buf, uint64_t length);
+    bool readRing(Ring &ring, void *buf, uint64_t length);
+
+    void send(const void *buf, unsigned length);
+    void establishConnection();
+
+  protected:
+
+    void sendPacket(const Header &header,
+                    const EthPacketPtr &packet) override;
+
+    void sendCmd(const Header &header) override;
+
+    bool recvHeader(Header &header) override;
+
+    void recvPacket(const Header &header, EthPacketPtr &packet) override;
+
+    void initTransport() override;
+
+  public:
+    /**
+     * @param server_port The port number of the server, which names the
+     * channels of the dist run.
+     * @param sync_start The tick for the first dist synchronisation.
+     * @param sync_repeat The frequency of dist synchronisation.
+     * @param em The EventManager object associated with the simulated
+     * link.
+     */
+    ShmIface(unsigned server_port, unsigned dist_rank, unsigned dist_size,
+             Tick sync_start, Tick sync_repeat, EventManager *em,
+             bool use_pseudo_op, bool is_switch, int num_nodes);
+
+    ~ShmIface() override;
+};
+
+} // namespace gem5
+
+#endif // __DEV_NET_SHM_IFACE_HH__
@@ -1,5 +1,6 @@
 from m5.objects.PciDevice import *
 from m5.params import *
+from m5.SimObject import cxxMethod
 
 
 class CXLMemory(PciDevice):
@@ -28,6 +29,39 @@ class CXLMemory(PciDevice):
         "2GB",
         "CXL expander memory range that can be identified as system memory",
     )
+    miss_tracker = Param.CXLMissTracker(
+        NULL,
+        "Tracker of the misses outstanding in the device and its media",
+    )
+    link_power = Param.CXLLinkPower(
+        NULL,
+        "Energy model of the CXL link and controller, which also delays "
+        "the messages while the link leaves its low power states",
+    )
+    qos = Param.CXLQoS(
+        NULL, "Traffic classes of the requests, served in priority order"
+    )
+
+    @cxxMethod(override=True)
+    def setProtoProcLat(self, proto_proc_lat):
+        """Drains the system and changes the protocol processing latency of
+        the device, e.g., ``setProtoProcLat("30ns")`` to throttle it. The
+        simulation continues with the new latency when it is run again.
+        """
+        from m5.simulate import drain
+
+        drain()
+        self.getCCObject().setProtoProcLat(Latency(proto_proc_lat).getValue())
+
+    @cxxMethod(override=True)
+    def setQueueLimits(self, req_size, rsp_size):
+        """Drains the system and changes the number of requests and
+        responses the device buffers.
+        """
+        from m5.simulate import drain
+
+        drain()
+        self.getCCObject().setQueueLimits(req_size, rsp_size)
 
     # ========================================================================
     # Near-Memory Processor (NMP) Configuration
@@ -4,6 +4,7 @@
 #include "base/trace.hh"
 #include "cpu/thread_context.hh"
 #include "debug/CXLMemory.hh"
+#include "debug/Drain.hh"
 
 namespace gem5
 {
@@ -46,6 +47,12 @@ CXLMemory::CXLMemory(const Params &p)
     nmpStartAddr(p.nmp_start_addr),
     nmpBinaryPath(p.nmp_binary),
     stats(*this),
+    missTracker(p.miss_tracker),
+    missLevel(missTracker ? missTracker->registerLevel(name()) : -1),
+    mediaMissLevel(missTracker ?
+            missTracker->registerLevel(name() + ".media") : -1),
+    linkPower(p.link_power),
+    qos(p.qos),
     nmpStats(*this)
     {
         DPRINTF(CXLMemory, "BAR0_addr:0x%lx, BAR0_size:0x%lx\n",
@@ -207,10 +214,63 @@ CXLMemory::getAddrRanges() const
     return PciDevice::getAddrRanges();
 }
 
+Tick
+CXLMemory::linkTransfer(PacketPtr pkt)
+{
+    if (!linkPower)
+        return 0;
+    return linkPower->transfer(pkt->hasData() ? pkt->getSize() : 0);
+}
+
+void
+CXLMemory::checkDrain()
+{
+    if (drainState() == DrainState::Draining && !cxlRspPort.busy() &&
+        !memReqPort.busy()) {
+        DPRINTF(Drain, "CXLMemory done draining\n");
+        signalDrainDone();
+    }
+}
+
+DrainState
+CXLMemory::drain()
+{
+    // the DMA port drains on its own, the CXL.mem ports only wait for
+    // the packets the device holds to leave
+    if (cxlRspPort.busy() || memReqPort.busy())
+        return DrainState::Draining;
+    return DrainState::Drained;
+}
+
+void
+CXLMemory::setProtoProcLat(Tick proto_proc_lat)
+{
+    fatal_if(drainState() != DrainState::Drained, "%s: the latency can "
+             "only change while the system is drained", name());
+
+    DPRINTF(CXLMemory, "Setting proto_proc_lat %d\n", proto_proc_lat);
+    cxlRspPort.setProtoProcLat(ticksToCycles(proto_proc_lat));
+    memReqPort.setProtoProcLat(ticksToCycles(proto_proc_lat));
+}
+
+void
+CXLMemory::setQueueLimits(unsigned int req_limit, unsigned int resp_limit)
+{
+    fatal_if(drainState() != DrainState::Drained, "%s: the queue sizes can "
+             "only change while the system is drained", name());
+    fatal_if(req_limit == 0 || resp_limit == 0, "%s: the queues need room "
+             "for at least one packet", name());
+
+    DPRINTF(CXLMemory, "Setting req_size %d rsp_size %d\n", req_limit,
+            resp_limit);
+    memReqPort.setQueueLimit(req_limit);
+    cxlRspPort.setQueueLimit(resp_limit);
+}
+
 bool
 CXLMemory::CXLResponsePort::respQueueFull() const
 {
-    if (outstandingResponses == respQueueLimit) {
+    if (outstandingResponses >= respQueueLimit) {
         cxlMemory.stats.rspQueFullEvents++;
         return true;
     } else {
@@ -221,7 +281,7 @@ CXLMemory::CXLResponsePort::respQueueFull() const
 bool
 CXLMemory::CXLRequestPort::reqQueueFull() const
 {
-    if (transmitList.size() == reqQueueLimit) {
+    if (transmitList.size() >= reqQueueLimit) {
         cxlMemory.stats.reqQueFullEvents++;
         return true;
     } else {
@@ -239,6 +299,9 @@ CXLMemory::CXLRequestPort::recvTimingResp(PacketPtr pkt)
 
     DPRINTF(CXLMemory, "Request queue size: %d\n", transmitList.size());
 
+    if (cxlMemory.missTracker)
+        cxlMemory.missTracker->leave(cxlMemory.mediaMissLevel, pkt);
+
     if (cxlMemory.preRspTick == -1) {
         cxlMemory.preRspTick = cxlMemory.clockEdge();
     } else {
@@ -252,8 +315,11 @@ CXLMemory::CXLRequestPort::recvTimingResp(PacketPtr pkt)
     Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
     pkt->headerDelay = pkt->payloadDelay = 0;
 
+    // the response may have to wait for the link to wake up
+    Tick wake_delay = cxlMemory.linkTransfer(pkt);
+
     cxlRspPort.schedTimingResp(pkt, cxlMemory.clockEdge(protoProcLat) +
-                              receive_delay);
+                              receive_delay + wake_delay);
 
     return true;
 }
@@ -293,15 +359,25 @@ CXLMemory::CXLResponsePort::recvTimingReq(PacketPtr pkt)
                 // no need to set retryReq to false as this is already the
                 // case
                 cxlMemory.stats.rspOutStandDist.sample(outstandingResponses);
+
+                if (cxlMemory.missTracker) {
+                    cxlMemory.missTracker->enter(cxlMemory.missLevel, pkt,
+                                                 pkt->getAddr(),
+                                                 pkt->req->requestorId());
+                }
             }
         }
 
         if (!retryReq) {
             Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
             pkt->headerDelay = pkt->payloadDelay = 0;
+            if (cxlMemory.qos)
+                cxlMemory.qos->tag(pkt);
+            // the request only gets across once the link is awake
+            Tick wake_delay = cxlMemory.linkTransfer(pkt);
 
             memReqPort.schedTimingReq(pkt, cxlMemory.clockEdge(protoProcLat) +
-                                      receive_delay);
+                                      receive_delay + wake_delay);
         }
     }
 
@@ -358,7 +434,10 @@ CXLMemory::CXLRequestPort::trySendTiming()
 {
     assert(!transmitList.empty());
 
-    DeferredPacket req = transmitList.front();
+    // with traffic classes the highest priority packet ready goes first
+    auto it = cxlMemory.qos ? cxlMemory.qos->select(transmitList) :
+                              transmitList.begin();
+    DeferredPacket req = *it;
 
     assert(req.tick <= curTick());
 
@@ -367,12 +446,22 @@ CXLMemory::CXLRequestPort::trySendTiming()
     DPRINTF(CXLMemory, "trySend request addr 0x%x, queue size %d\n",
             pkt->getAddr(), transmitList.size());
 
+    // the media may free packets that need no response when sending
+    const bool needs_response = pkt->needsResponse();
+    const Addr addr = pkt->getAddr();
+    const RequestorID requestor = pkt->req->requestorId();
+
     if (sendTimingReq(pkt)) {
         // send successful
         cxlMemory.stats.reqSendSucceed++;
+
+        if (cxlMemory.missTracker && needs_response) {
+            cxlMemory.missTracker->enter(cxlMemory.mediaMissLevel, pkt, addr,
+                                         requestor);
+        }
         cxlMemory.stats.reqQueueLatDist.sample(curTick() - req.entryTime);
 
-        transmitList.pop_front();
+        transmitList.erase(it);
 
         cxlMemory.stats.reqQueueLenDist.sample(transmitList.size());
         DPRINTF(CXLMemory, "trySend request successful\n");
@@ -390,6 +479,8 @@ CXLMemory::CXLRequestPort::trySendTiming()
         // request we stalled was waiting for the response queue
         // rather than the request queue we might stall it again
         cxlRspPort.retryStalledReq();
+
+        cxlMemory.checkDrain();
     } else {
         cxlMemory.stats.reqSendFaild++;
     }
@@ -403,7 +494,10 @@ CXLMemory::CXLResponsePort::trySendTiming()
 {
     assert(!transmitList.empty());
 
-    DeferredPacket resp = transmitList.front();
+    // with traffic classes the highest priority packet ready goes first
+    auto it = cxlMemory.qos ? cxlMemory.qos->select(transmitList) :
+                              transmitList.begin();
+    DeferredPacket resp = *it;
 
     assert(resp.tick <= curTick());
 
@@ -417,7 +511,7 @@ CXLMemory::CXLResponsePort::trySendTiming()
         cxlMemory.stats.rspSendSucceed++;
         cxlMemory.stats.rspQueueLatDist.sample(curTick() - resp.entryTime);
 
-        transmitList.pop_front();
+        transmitList.erase(it);
 
         cxlMemory.stats.rspQueueLenDist.sample(transmitList.size());
         DPRINTF(CXLMemory, "trySend response successful\n");
@@ -427,6 +521,10 @@ CXLMemory::CXLResponsePort::trySendTiming()
 
         cxlMemory.stats.rspOutStandDist.sample(outstandingResponses);
 
+        // the packet may be gone already, it only serves as the key
+        if (cxlMemory.missTracker)
+            cxlMemory.missTracker->leave(cxlMemory.missLevel, pkt);
+
         // If there are more packets to send, schedule event to try again.
         if (!transmitList.empty()) {
             DeferredPacket next_resp = transmitList.front();
@@ -444,6 +542,8 @@ CXLMemory::CXLResponsePort::trySendTiming()
             sendRetryReq();
             cxlMemory.stats.reqRetryCounts++;
         }
+
+        cxlMemory.checkDrain();
     } else {
         cxlMemory.stats.rspSendFaild++;
     }
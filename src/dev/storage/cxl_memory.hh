@@ -10,6 +10,9 @@
 #include "cpu/base.hh"
 #include "cpu/thread_context.hh"
 #include "dev/pci/device.hh"
+#include "mem/cxl_link_power.hh"
+#include "mem/cxl_miss_tracker.hh"
+#include "mem/cxl_qos.hh"
 #include "mem/packet.hh"
 #include "mem/packet_access.hh"
 #include "mem/port.hh"
@@ -61,7 +64,7 @@ class CXLMemory : public PciDevice
                 CXLRequestPort& memReqPort;
 
                 /** Latency in protocol processing by CXLMemory. */
-                const Cycles protoProcLat;
+                Cycles protoProcLat;
 
                 /** Address ranges to pass through the CXLMemory */
                 const AddrRange cxlMemRange;
@@ -136,6 +139,21 @@ class CXLMemory : public PciDevice
                 */
                 void retryStalledReq();
 
+                /**
+                * Are responses queued or expected from the media?
+                */
+                bool busy() const { return outstandingResponses != 0; }
+
+                /** Change the latency, only while the CXLMemory is drained. */
+                void setProtoProcLat(Cycles lat) { protoProcLat = lat; }
+
+                /** Change the response queue size, as for the latency. */
+                void
+                setQueueLimit(unsigned int limit)
+                {
+                    respQueueLimit = limit;
+                }
+
             // protected:
                 /** When receiving a timing request from the Host,
                     pass it to the back-end memory media. */
@@ -182,7 +200,7 @@ class CXLMemory : public PciDevice
                 CXLResponsePort& cxlRspPort;
 
                 /** Latency in protocol processing by CXLMemory. */
-                const Cycles protoProcLat;
+                Cycles protoProcLat;
 
                 /**
                 * Request packet queue. Request packets are held in this
@@ -192,7 +210,7 @@ class CXLMemory : public PciDevice
                 std::deque<DeferredPacket> transmitList;
 
                 /** Max queue size for request packets */
-                const unsigned int reqQueueLimit;
+                unsigned int reqQueueLimit;
 
                 /**
                 * Handle send event, scheduled when the packet at the head of
@@ -234,6 +252,21 @@ class CXLMemory : public PciDevice
                 */
                 void schedTimingReq(PacketPtr pkt, Tick when);
 
+                /**
+                * Are requests queued?
+                */
+                bool busy() const { return !transmitList.empty(); }
+
+                /** Change the latency, only while the CXLMemory is drained. */
+                void setProtoProcLat(Cycles lat) { protoProcLat = lat; }
+
+                /** Change the request queue size, as for the latency. */
+                void
+                setQueueLimit(unsigned int limit)
+                {
+                    reqQueueLimit = limit;
+                }
+
             protected:
                 /** When receiving a timing request from the back-end memory media,
                     pass it to the Host. */
@@ -331,6 +364,25 @@ class CXLMemory : public PciDevice
 
         CXLCtrlStats stats;
 
+        /** Tracker of the outstanding misses, if any */
+        CXLMissTracker *missTracker;
+
+        /** Levels of the device and of its media in the tracker */
+        const int missLevel;
+        const int mediaMissLevel;
+
+        /** Energy model of the link and the controller, if any */
+        CXLLinkPower *linkPower;
+
+        /**
+         * A message crosses the link, returns the time it waits for the
+         * link to wake up.
+         */
+        Tick linkTransfer(PacketPtr pkt);
+
+        /** Traffic classes of the requests, if any */
+        CXLQoS *qos;
+
         /**
          * Statistics for Near-Memory Processor (NMP) operations
          * Tracks memory accesses from NMP CPU to local memory
@@ -357,6 +409,9 @@ class CXLMemory : public PciDevice
 
         NMPStats nmpStats;
 
+        /** Finish draining once the last packet has left the CXLMemory */
+        void checkDrain();
+
     public:
         Tick read(PacketPtr pkt) override {
             return cxlRspPort.recvAtomic(pkt);
@@ -371,6 +426,27 @@ class CXLMemory : public PciDevice
 
         AddrRangeList getAddrRanges() const override;
 
+        DrainState drain() override;
+
+        /**
+         * Change the protocol processing latency, in ticks, while
+         * simulating, e.g., to throttle the device. The CXLMemory must be
+         * drained, so that the packets it holds were all delayed by the
+         * same amount. The value is not checkpointed.
+         *
+         * @param proto_proc_lat the latency of the CXL controller
+         */
+        void setProtoProcLat(Tick proto_proc_lat);
+
+        /**
+         * Change the sizes of the request and response queues, while the
+         * CXLMemory is drained.
+         *
+         * @param req_limit the number of requests to buffer
+         * @param resp_limit the number of responses to buffer
+         */
+        void setQueueLimits(unsigned int req_limit, unsigned int resp_limit);
+
         /**
          * Initialize the NMP CPU at the CXL device
          * Called during system initialization if NMP is enabled
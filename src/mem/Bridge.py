@@ -38,6 +38,7 @@
 
 from m5.objects.ClockedObject import ClockedObject
 from m5.params import *
+from m5.SimObject import cxxMethod
 
 
 class Bridge(ClockedObject):
@@ -87,6 +88,39 @@ class CXLBridge(ClockedObject):
     resp_fifo_depth = Param.Unsigned(48, "The number of responses to buffer")
     bridge_lat = Param.Latency("50ns", "The latency of this bridge")
     proto_proc_lat = Param.Latency("14ns", "Conversion latency of cxl protocol in bridge")
+    miss_tracker = Param.CXLMissTracker(
+        NULL,
+        "Tracker of the misses outstanding in the bridge, which also "
+        "limits the CXL misses each requestor may have in flight",
+    )
+    qos = Param.CXLQoS(
+        NULL,
+        "Traffic classes of the requests to CXL memory, which are served "
+        "in priority order",
+    )
     ranges = VectorParam.AddrRange(
         [AllMemory], "Address ranges to pass through the bridge"
     )
+
+    @cxxMethod(override=True)
+    def setLatencies(self, bridge_lat, proto_proc_lat):
+        """Drains the system and changes the latencies of the bridge, e.g.,
+        ``setLatencies("50ns", "24ns")``. The simulation continues with the
+        new latencies when it is run again.
+        """
+        from m5.simulate import drain
+
+        drain()
+        self.getCCObject().setLatencies(
+            Latency(bridge_lat).getValue(), Latency(proto_proc_lat).getValue()
+        )
+
+    @cxxMethod(override=True)
+    def setQueueLimits(self, req_fifo_depth, resp_fifo_depth):
+        """Drains the system and changes the number of requests and
+        responses the bridge buffers.
+        """
+        from m5.simulate import drain
+
+        drain()
+        self.getCCObject().setQueueLimits(req_fifo_depth, resp_fifo_depth)
@@ -0,0 +1,44 @@
+from m5.params import *
+from m5.SimObject import SimObject
+
+
+class CXLLinkPower(SimObject):
+    """Energy of a CXL link and of the controller of the device at its end.
+
+    The device reports every message crossing the link. The link draws a
+    fixed energy per flit and a static power that depends on its state: L0
+    while it is used, then L0s and L1 after it has been idle for a while.
+    Messages wait for the link to leave a low power state, so aggressive
+    link power management shows up as latency. The energy is reported in pJ
+    and the power in mW, as for DRAM.
+
+    The default energies and powers are rough figures for a x16 link at
+    32 GT/s, adjust them to the device being modelled. An idle time of 0
+    disables the corresponding state.
+    """
+
+    type = "CXLLinkPower"
+    cxx_header = "mem/cxl_link_power.hh"
+    cxx_class = "gem5::CXLLinkPower"
+
+    flit_energy = Param.Energy("2.2nJ", "Energy of a 68-byte flit")
+    ctrl_energy = Param.Energy(
+        "0.5nJ", "Energy of the controller processing a message"
+    )
+
+    l0_power = Param.Float(2000.0, "Power of the link in L0 (mW)")
+    l0s_power = Param.Float(600.0, "Power of the link in L0s (mW)")
+    l1_power = Param.Float(100.0, "Power of the link in L1 (mW)")
+    ctrl_idle_power = Param.Float(500.0, "Idle power of the controller (mW)")
+
+    l0s_idle = Param.Latency(
+        "1us", "Idle time before the link enters L0s, 0 to disable L0s"
+    )
+    l0s_entry_lat = Param.Latency("20ns", "Time to enter L0s")
+    l0s_exit_lat = Param.Latency("100ns", "Time to exit L0s")
+
+    l1_idle = Param.Latency(
+        "10us", "Idle time before the link enters L1, 0 to disable L1"
+    )
+    l1_entry_lat = Param.Latency("1us", "Time to enter L1")
+    l1_exit_lat = Param.Latency("2us", "Time to exit L1")
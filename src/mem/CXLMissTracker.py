@@ -0,0 +1,34 @@
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+
+class CXLMissTracker(SimObject):
+    """Tracks the misses outstanding at each level of the path to memory.
+
+    Caches, CXLBridges and CXLMemory devices that point to the tracker
+    report when a miss enters and leaves them. The tracker keeps, per
+    level and per tier (local memory or CXL memory), the occupancy seen by
+    arriving misses, the time-averaged occupancy and the average latency,
+    so bandwidth limits can be checked against Little's law. It can also
+    cap the number of CXL misses a requestor (e.g., a core) may have in
+    flight past the CXLBridge.
+    """
+
+    type = "CXLMissTracker"
+    cxx_header = "mem/cxl_miss_tracker.hh"
+    cxx_class = "gem5::CXLMissTracker"
+
+    system = Param.System(Parent.any, "System the tracker belongs to")
+
+    cxl_ranges = VectorParam.AddrRange(
+        [], "Address ranges served by CXL memory, all others are local"
+    )
+    max_cxl_mlp = Param.Unsigned(
+        0,
+        "Maximum number of CXL misses a requestor may have outstanding "
+        "past the CXLBridge, 0 for no limit",
+    )
+    occupancy_bins = Param.Unsigned(
+        256, "Largest occupancy in the occupancy histograms"
+    )
@@ -0,0 +1,34 @@
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+
+class CXLQoS(SimObject):
+    """QoS priorities of the traffic to CXL memory.
+
+    Each requestor is given a priority by the first entry of ``requestors``
+    its name starts with, e.g., ``"board.processor.cores0"`` for all the
+    ports of a core, and ``default_priority`` if none matches. The
+    CXLBridges and CXLMemory devices that point to this object tag the
+    packets with the priority of their requestor and serve their queues
+    in priority order, highest first. The priority stays with the packets,
+    so a QoS memory controller with ``qos_priorities`` set and no policy
+    of its own arbitrates with it as well.
+    """
+
+    type = "CXLQoS"
+    cxx_header = "mem/cxl_qos.hh"
+    cxx_class = "gem5::CXLQoS"
+
+    system = Param.System(Parent.any, "System the requestors belong to")
+
+    priorities = Param.Unsigned(2, "Number of QoS priorities")
+    requestors = VectorParam.String(
+        [], "Prefixes of the names of the requestors of each traffic class"
+    )
+    requestor_priorities = VectorParam.UInt8(
+        [], "Priority of each entry of requestors, higher is served first"
+    )
+    default_priority = Param.UInt8(
+        0, "Priority of the requestors that are not listed"
+    )
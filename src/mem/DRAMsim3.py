@@ -57,6 +57,15 @@ class DRAMsim3(AbstractMemory):
         "ext/dramsim3/DRAMsim3/", "Directory to prepend to file names"
     )
 
+    # DRAMsim3 is only ticked while it has transactions in flight. The
+    # cycles it was idle for are simulated back to back when the next
+    # request arrives, which gives the same timing as ticking it every
+    # cycle, or skipped altogether, which is faster but leaves out the
+    # refreshes and power state changes of the idle time.
+    skip_idle_cycles = Param.Bool(
+        False, "Skip the idle cycles rather than simulate them"
+    )
+
 
 add_citation(
     DRAMsim3,
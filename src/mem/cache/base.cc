@@ -87,6 +87,8 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       tags(p.tags),
       compressor(p.compressor),
       prefetcher(p.prefetcher),
+      missTracker(p.miss_tracker),
+      missLevel(missTracker ? missTracker->registerLevel(name()) : -1),
       writeAllocator(p.write_allocator),
       writebackClean(p.writeback_clean),
       tempBlockWriteback(nullptr),
@@ -602,6 +604,8 @@ BaseCache::recvTimingResp(PacketPtr pkt)
             // check the isFull condition before and after as we might
             // have been using the reserved entries already
             const bool was_full = mshrQueue.isFull();
+            if (missTracker)
+                missTracker->leave(missLevel, mshr);
             mshrQueue.deallocate(mshr);
             if (was_full && !mshrQueue.isFull()) {
                 clearBlocked(Blocked_NoMSHRs);
@@ -65,6 +65,7 @@
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/write_queue.hh"
 #include "mem/cache/write_queue_entry.hh"
+#include "mem/cxl_miss_tracker.hh"
 #include "mem/packet.hh"
 #include "mem/packet_queue.hh"
 #include "mem/qport.hh"
@@ -354,6 +355,12 @@ class BaseCache : public ClockedObject
     /** Prefetcher */
     prefetch::Base *prefetcher;
 
+    /** Tracker of the misses outstanding in the MSHRs, if any */
+    CXLMissTracker *missTracker;
+
+    /** Level of this cache in the miss tracker */
+    const int missLevel;
+
     /** To probe when a cache hit occurs */
     ProbePointArg<CacheAccessProbeArg> *ppHit;
 
@@ -1175,6 +1182,11 @@ class BaseCache : public ClockedObject
                                         pkt, time, order++,
                                         allocOnFill(pkt->cmd));
 
+        if (missTracker) {
+            missTracker->enter(missLevel, mshr, mshr->blkAddr,
+                               pkt->req->requestorId());
+        }
+
         if (mshrQueue.isFull()) {
             setBlocked((BlockedCause)MSHRQueue_MSHRs);
         }
@@ -1481,6 +1481,8 @@ Cache::sendMSHRQueuePacket(MSHR* mshr)
                 // mshr when all had previously been utilized
                 clearBlocked(Blocked_NoMSHRs);
             }
+            if (missTracker && !mshr->hasTargets())
+                missTracker->leave(missLevel, mshr);
 
             // given that no response is expected, delete Request and Packet
             delete tgt_pkt;
@@ -48,6 +48,7 @@
 
 #include "base/trace.hh"
 #include "debug/Bridge.hh"
+#include "debug/Drain.hh"
 #include "params/Bridge.hh"
 #include "debug/CXLMemory.hh"
 #include <iterator>
@@ -91,7 +92,9 @@ CXLBridge::CXLBridge(const Params &p)
                 ticksToCycles(p.bridge_lat), ticksToCycles(p.proto_proc_lat), p.resp_fifo_depth, p.ranges),
       memSidePort(p.name + ".mem_side_port", *this, cpuSidePort,
                 ticksToCycles(p.bridge_lat), ticksToCycles(p.proto_proc_lat), p.req_fifo_depth),      
-      stats(*this)
+      stats(*this), missTracker(p.miss_tracker),
+      missLevel(missTracker ? missTracker->registerLevel(name()) : -1),
+      qos(p.qos)
 {
 }
 
@@ -161,7 +164,7 @@ CXLBridge::init()
 bool
 CXLBridge::BridgeResponsePort::respQueueFull() const
 {
-    if (outstandingResponses == respQueueLimit) {
+    if (outstandingResponses >= respQueueLimit) {
         bridge.stats.rspQueFullEvents++;
         return true;
     } else {
@@ -172,7 +175,7 @@ CXLBridge::BridgeResponsePort::respQueueFull() const
 bool
 CXLBridge::BridgeRequestPort::reqQueueFull() const
 {
-    if (transmitList.size() == reqQueueLimit) {
+    if (transmitList.size() >= reqQueueLimit) {
         bridge.stats.reqQueFullEvents++;
         return true;
     } else {
@@ -180,6 +183,61 @@ CXLBridge::BridgeRequestPort::reqQueueFull() const
     }
 }
 
+bool
+CXLBridge::BridgeResponsePort::busy() const
+{
+    // the responses still in the queue are outstanding as well
+    return outstandingResponses != 0;
+}
+
+void
+CXLBridge::checkDrain()
+{
+    if (drainState() == DrainState::Draining && !cpuSidePort.busy() &&
+        !memSidePort.busy()) {
+        DPRINTF(Drain, "CXLBridge done draining\n");
+        signalDrainDone();
+    }
+}
+
+DrainState
+CXLBridge::drain()
+{
+    // the ports only wait for their peers, so the bridge is drained
+    // once the packets it holds have left
+    if (cpuSidePort.busy() || memSidePort.busy())
+        return DrainState::Draining;
+    return DrainState::Drained;
+}
+
+void
+CXLBridge::setLatencies(Tick bridge_lat, Tick proto_proc_lat)
+{
+    fatal_if(drainState() != DrainState::Drained, "%s: the latencies can "
+             "only change while the system is drained", name());
+
+    DPRINTF(Bridge, "Setting bridge_lat %d proto_proc_lat %d\n",
+            bridge_lat, proto_proc_lat);
+    cpuSidePort.setLatencies(ticksToCycles(bridge_lat),
+                             ticksToCycles(proto_proc_lat));
+    memSidePort.setLatencies(ticksToCycles(bridge_lat),
+                             ticksToCycles(proto_proc_lat));
+}
+
+void
+CXLBridge::setQueueLimits(unsigned int req_limit, unsigned int resp_limit)
+{
+    fatal_if(drainState() != DrainState::Drained, "%s: the queue sizes can "
+             "only change while the system is drained", name());
+    fatal_if(req_limit == 0 || resp_limit == 0, "%s: the queues need room "
+             "for at least one packet", name());
+
+    DPRINTF(Bridge, "Setting req_fifo_depth %d resp_fifo_depth %d\n",
+            req_limit, resp_limit);
+    memSidePort.setQueueLimit(req_limit);
+    cpuSidePort.setQueueLimit(resp_limit);
+}
+
 bool
 CXLBridge::BridgeRequestPort::recvTimingResp(PacketPtr pkt)
 {
@@ -237,6 +295,14 @@ CXLBridge::BridgeResponsePort::recvTimingReq(PacketPtr pkt)
     if (memSidePort.reqQueueFull()) {
         DPRINTF(Bridge, "Request queue full\n");
         retryReq = true;
+    } else if (bridge.missTracker && pkt->needsResponse() &&
+               bridge.missTracker->mlpLimited(bridge.missLevel,
+                                              pkt->getAddr(),
+                                              pkt->req->requestorId())) {
+        // the requestor has too many CXL misses in flight, try again
+        // once one of our responses has gone out
+        DPRINTF(Bridge, "CXL MLP limit reached\n");
+        retryReq = true;
     } else {
         // look at the response queue if we expect to see a response
         bool expects_response = pkt->needsResponse();
@@ -253,6 +319,12 @@ CXLBridge::BridgeResponsePort::recvTimingReq(PacketPtr pkt)
                 // no need to set retryReq to false as this is already the
                 // case
                 bridge.stats.rspOutStandDist.sample(outstandingResponses);
+
+                if (bridge.missTracker) {
+                    bridge.missTracker->enter(bridge.missLevel, pkt,
+                                              pkt->getAddr(),
+                                              pkt->req->requestorId());
+                }
             }
         }
 
@@ -266,6 +338,8 @@ CXLBridge::BridgeResponsePort::recvTimingReq(PacketPtr pkt)
             auto total_delay = bridge_lat;
             if (pkt->getAddr() >= cxl_range.start() && pkt->getAddr() < cxl_range.end()) {
                 total_delay = bridge_lat + proto_proc_lat;
+                if (bridge.qos)
+                    bridge.qos->tag(pkt);
                 if (pkt->isRead())
                     pkt->cxl_cmd = MemCmd::M2SReq;
                 else if(pkt->isWrite())
@@ -338,7 +412,10 @@ CXLBridge::BridgeRequestPort::trySendTiming()
 {
     assert(!transmitList.empty());
 
-    DeferredPacket req = transmitList.front();
+    // with traffic classes the highest priority packet ready goes first
+    auto it = bridge.qos ? bridge.qos->select(transmitList) :
+                           transmitList.begin();
+    DeferredPacket req = *it;
 
     assert(req.tick <= curTick());
 
@@ -351,7 +428,7 @@ CXLBridge::BridgeRequestPort::trySendTiming()
         // send successful
         bridge.stats.reqSendSucceed++;
 
-        transmitList.pop_front();
+        transmitList.erase(it);
 
         bridge.stats.reqQueueLenDist.sample(transmitList.size());
         DPRINTF(Bridge, "trySend request successful\n");
@@ -369,6 +446,8 @@ CXLBridge::BridgeRequestPort::trySendTiming()
         // request we stalled was waiting for the response queue
         // rather than the request queue we might stall it again
         cpuSidePort.retryStalledReq();
+
+        bridge.checkDrain();
     } else {
         bridge.stats.reqSendFaild++;
     }
@@ -382,7 +461,10 @@ CXLBridge::BridgeResponsePort::trySendTiming()
 {
     assert(!transmitList.empty());
 
-    DeferredPacket resp = transmitList.front();
+    // with traffic classes the highest priority packet ready goes first
+    auto it = bridge.qos ? bridge.qos->select(transmitList) :
+                           transmitList.begin();
+    DeferredPacket resp = *it;
 
     assert(resp.tick <= curTick());
 
@@ -395,7 +477,7 @@ CXLBridge::BridgeResponsePort::trySendTiming()
         // send successful
         bridge.stats.rspSendSucceed++;
 
-        transmitList.pop_front();
+        transmitList.erase(it);
 
         bridge.stats.rspQueueLenDist.sample(transmitList.size());
         DPRINTF(Bridge, "trySend response successful\n");
@@ -405,6 +487,10 @@ CXLBridge::BridgeResponsePort::trySendTiming()
 
         bridge.stats.rspOutStandDist.sample(outstandingResponses);
 
+        // the packet may be gone already, it only serves as the key
+        if (bridge.missTracker)
+            bridge.missTracker->leave(bridge.missLevel, pkt);
+
         // If there are more packets to send, schedule event to try again.
         if (!transmitList.empty()) {
             DeferredPacket next_resp = transmitList.front();
@@ -422,6 +508,8 @@ CXLBridge::BridgeResponsePort::trySendTiming()
             sendRetryReq();
             bridge.stats.reqRetryCounts++;
         }
+
+        bridge.checkDrain();
     } else {
         bridge.stats.rspSendFaild++;
     }
@@ -51,6 +51,8 @@
 
 #include "base/types.hh"
 #include "base/statistics.hh"
+#include "mem/cxl_miss_tracker.hh"
+#include "mem/cxl_qos.hh"
 #include "mem/port.hh"
 #include "params/CXLBridge.hh"
 #include "sim/clocked_object.hh"
@@ -101,10 +103,10 @@ class CXLBridge : public ClockedObject
         BridgeRequestPort& memSidePort;
 
         /** Minimum request delay though this bridge. */
-        const Cycles bridge_lat;
+        Cycles bridge_lat;
 
         /** Conversion delay of cxl protocol in bridge*/        
-        const Cycles proto_proc_lat;
+        Cycles proto_proc_lat;
 
         /** Address ranges to pass through the bridge */
         const AddrRangeList ranges;
@@ -183,6 +185,22 @@ class CXLBridge : public ClockedObject
          */
         void retryStalledReq();
 
+        /**
+         * Are responses queued or expected from the other side?
+         */
+        bool busy() const;
+
+        /** Change the delays, only while the bridge is drained. */
+        void
+        setLatencies(Cycles _bridge_lat, Cycles _proto_proc_lat)
+        {
+            bridge_lat = _bridge_lat;
+            proto_proc_lat = _proto_proc_lat;
+        }
+
+        /** Change the size of the response queue, as for the delays. */
+        void setQueueLimit(unsigned int limit) { respQueueLimit = limit; }
+
         AddrRange cxl_range;
 
       protected:
@@ -240,10 +258,10 @@ class CXLBridge : public ClockedObject
         BridgeResponsePort& cpuSidePort;
 
         /** Minimum delay though this bridge. */
-        const Cycles bridge_lat;
+        Cycles bridge_lat;
 
         /** Conversion delay of cxl protocol in bridge*/        
-        const Cycles proto_proc_lat;
+        Cycles proto_proc_lat;
 
         /**
          * Request packet queue. Request packets are held in this
@@ -254,7 +272,7 @@ class CXLBridge : public ClockedObject
         std::deque<DeferredPacket> transmitList;
 
         /** Max queue size for request packets */
-        const unsigned int reqQueueLimit;
+        unsigned int reqQueueLimit;
 
         /**
          * Handle send event, scheduled when the packet at the head of
@@ -309,6 +327,22 @@ class CXLBridge : public ClockedObject
          */
         bool trySatisfyFunctional(PacketPtr pkt);
 
+        /**
+         * Are requests queued?
+         */
+        bool busy() const { return !transmitList.empty(); }
+
+        /** Change the delays, only while the bridge is drained. */
+        void
+        setLatencies(Cycles _bridge_lat, Cycles _proto_proc_lat)
+        {
+            bridge_lat = _bridge_lat;
+            proto_proc_lat = _proto_proc_lat;
+        }
+
+        /** Change the size of the request queue, as for the delays. */
+        void setQueueLimit(unsigned int limit) { reqQueueLimit = limit; }
+
       protected:
 
         /** When receiving a timing request from the peer port,
@@ -346,6 +380,18 @@ class CXLBridge : public ClockedObject
 
     CXLBridgeStats stats;
 
+    /** Tracker of the outstanding misses, if any */
+    CXLMissTracker *missTracker;
+
+    /** Level of this bridge in the tracker */
+    const int missLevel;
+
+    /** Traffic classes of the requests to CXL memory, if any */
+    CXLQoS *qos;
+
+    /** Finish draining once the last packet has left the bridge */
+    void checkDrain();
+
   public:
 
     Port &getPort(const std::string &if_name,
@@ -353,6 +399,28 @@ class CXLBridge : public ClockedObject
 
     void init() override;
 
+    DrainState drain() override;
+
+    /**
+     * Change the latencies of the bridge, in ticks, while simulating,
+     * e.g., to throttle it. The bridge must be drained, so that the
+     * packets it holds were all delayed by the same amounts. The values
+     * are not checkpointed.
+     *
+     * @param bridge_lat the latency of the bridge
+     * @param proto_proc_lat the conversion latency of the CXL protocol
+     */
+    void setLatencies(Tick bridge_lat, Tick proto_proc_lat);
+
+    /**
+     * Change the sizes of the request and response queues, while the
+     * bridge is drained.
+     *
+     * @param req_limit the number of requests to buffer
+     * @param resp_limit the number of responses to buffer
+     */
+    void setQueueLimits(unsigned int req_limit, unsigned int resp_limit);
+
     typedef CXLBridgeParams Params;
 
     CXLBridge(const Params &p);
@@ -0,0 +1,235 @@
+#include "mem/cxl_link_power.hh"
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+#include "base/trace.hh"
+#include "debug/CXLLinkPower.hh"
+#include "sim/core.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** Energy (pJ) drawn at a power (mW) over a number of ticks */
+double
+energy(double power, Tick ticks)
+{
+    return power * ticks * 1e9 / sim_clock::Frequency;
+}
+
+} // anonymous namespace
+
+CXLLinkPower::CXLLinkPower(const Params &p)
+    : SimObject(p), l0sIdle(p.l0s_idle), l1Idle(p.l1_idle),
+      l0sEntryLat(p.l0s_entry_lat), l0sExitLat(p.l0s_exit_lat),
+      l1EntryLat(p.l1_entry_lat), l1ExitLat(p.l1_exit_lat),
+      flitEnergy(p.flit_energy * 1e12), ctrlEnergy(p.ctrl_energy * 1e12),
+      statePower{p.l0_power, p.l0s_power, p.l1_power},
+      ctrlIdlePower(p.ctrl_idle_power),
+      idleSince(0), wakeDone(0), accountedUntil(0), lastStatsReset(0),
+      stats(*this)
+{
+}
+
+void
+CXLLinkPower::startup()
+{
+    // The link is up when the simulation starts, or is restored from a
+    // checkpoint
+    idleSince = wakeDone = accountedUntil = curTick();
+}
+
+Tick
+CXLLinkPower::stateStart(LinkState s) const
+{
+    Tick l1 = MaxTick;
+    if (l1Idle != 0)
+        l1 = idleSince + l1Idle + l1EntryLat;
+    if (s == L1)
+        return l1;
+
+    assert(s == L0s);
+    // L0s is skipped if the link goes to L1 first
+    if (l0sIdle == 0)
+        return l1;
+    return std::min(l1, idleSince + l0sIdle + l0sEntryLat);
+}
+
+CXLLinkPower::LinkState
+CXLLinkPower::state() const
+{
+    // The link counts as being in a state once it has entered it
+    if (curTick() >= stateStart(L1))
+        return L1;
+    if (curTick() >= stateStart(L0s))
+        return L0s;
+    return L0;
+}
+
+void
+CXLLinkPower::account(Tick until)
+{
+    if (until <= accountedUntil)
+        return;
+
+    const Tick begin[NumLinkStates] = {
+        0, stateStart(L0s), stateStart(L1)
+    };
+    const Tick end[NumLinkStates] = {
+        begin[L0s], begin[L1], MaxTick
+    };
+    for (int s = 0; s < NumLinkStates; s++) {
+        Tick from = std::max(accountedUntil, begin[s]);
+        Tick to = std::min(until, end[s]);
+        if (to <= from)
+            continue;
+        double e = energy(statePower[s], to - from);
+        stats.stateTime[s] += to - from;
+        stats.stateEnergy[s] += e;
+        stats.totalEnergy += e;
+    }
+
+    double e = energy(ctrlIdlePower, until - accountedUntil);
+    stats.ctrlIdleEnergy += e;
+    stats.totalEnergy += e;
+
+    accountedUntil = until;
+}
+
+Tick
+CXLLinkPower::transfer(unsigned data_bytes)
+{
+    const Tick now = curTick();
+    account(now);
+
+    Tick delay = 0;
+    if (now < wakeDone) {
+        // The link is already leaving a low power state
+        delay = wakeDone - now;
+    } else if (now >= idleSince) {
+        const Tick idle = now - idleSince;
+        LinkState target = L0;
+        Tick exit_lat = 0;
+        if (l1Idle != 0 && idle >= l1Idle) {
+            target = L1;
+            exit_lat = l1ExitLat;
+        } else if (l0sIdle != 0 && idle >= l0sIdle) {
+            target = L0s;
+            exit_lat = l0sExitLat;
+        }
+
+        if (target != L0) {
+            // Finish entering the state before leaving it
+            Tick entered = std::max(now, stateStart(target));
+            delay = entered - now + exit_lat;
+            wakeDone = now + delay;
+            stats.wakeUps[target]++;
+            DPRINTF(CXLLinkPower, "Waking up from %s after %d ticks idle, "
+                    "delay %d\n", target == L1 ? "L1" : "L0s", idle, delay);
+        }
+    }
+    stats.wakeDelay += delay;
+
+    idleSince = std::max(idleSince, now + delay);
+
+    const unsigned slots = 1 + divCeil(data_bytes, slotBytes);
+    const double e_flits = slots * flitEnergy / slotsPerFlit;
+    stats.messages++;
+    stats.slots += slots;
+    stats.dataBytes += data_bytes;
+    stats.flitEnergy += e_flits;
+    stats.ctrlDynEnergy += ctrlEnergy;
+    stats.totalEnergy += e_flits + ctrlEnergy;
+
+    return delay;
+}
+
+CXLLinkPower::CXLLinkPowerStats::CXLLinkPowerStats(CXLLinkPower &_power)
+    : statistics::Group(&_power), power(_power),
+
+      ADD_STAT(stateTime, statistics::units::Tick::get(),
+               "Time the link spent in each state"),
+      ADD_STAT(wakeUps, statistics::units::Count::get(),
+               "Number of times the link left a low power state"),
+      ADD_STAT(wakeDelay, statistics::units::Tick::get(),
+               "Total delay of the messages waiting for the link to wake "
+               "up"),
+      ADD_STAT(avgWakeDelay, statistics::units::Rate<
+                    statistics::units::Tick, statistics::units::Count>::get(),
+               "Average time the link took to wake up"),
+      ADD_STAT(messages, statistics::units::Count::get(),
+               "Number of messages that crossed the link"),
+      ADD_STAT(slots, statistics::units::Count::get(),
+               "Number of 16-byte flit slots the messages took"),
+      ADD_STAT(flits, statistics::units::Count::get(),
+               "Number of 68-byte flits the messages took"),
+      ADD_STAT(dataBytes, statistics::units::Byte::get(),
+               "Data carried by the messages"),
+      ADD_STAT(flitEnergy, statistics::units::Joule::get(),
+               "Energy of the flits on the link (pJ)"),
+      ADD_STAT(stateEnergy, statistics::units::Joule::get(),
+               "Static energy of the link in each state (pJ)"),
+      ADD_STAT(ctrlDynEnergy, statistics::units::Joule::get(),
+               "Energy of the controller processing the messages (pJ)"),
+      ADD_STAT(ctrlIdleEnergy, statistics::units::Joule::get(),
+               "Idle energy of the controller (pJ)"),
+      ADD_STAT(totalEnergy, statistics::units::Joule::get(),
+               "Total energy of the link and the controller (pJ)"),
+      ADD_STAT(energyPerBit, statistics::units::Rate<
+                    statistics::units::Joule, statistics::units::Bit>::get(),
+               "Total energy per bit of data (pJ/bit)"),
+      ADD_STAT(averagePower, statistics::units::Watt::get(),
+               "Average power of the link and the controller (mW)")
+{
+    stateTime
+        .init(NumLinkStates)
+        .subname(L0, "L0")
+        .subname(L0s, "L0s")
+        .subname(L1, "L1");
+    wakeUps
+        .init(NumLinkStates)
+        .subname(L0, "L0")
+        .subname(L0s, "L0s")
+        .subname(L1, "L1")
+        .flags(statistics::nozero);
+    stateEnergy
+        .init(NumLinkStates)
+        .subname(L0, "L0")
+        .subname(L0s, "L0s")
+        .subname(L1, "L1");
+
+    avgWakeDelay = wakeDelay / statistics::sum(wakeUps);
+    flits = slots / statistics::constant(slotsPerFlit);
+    energyPerBit = totalEnergy / (dataBytes * statistics::constant(8));
+}
+
+void
+CXLLinkPower::CXLLinkPowerStats::resetStats()
+{
+    statistics::Group::resetStats();
+
+    power.accountedUntil = curTick();
+    power.lastStatsReset = curTick();
+}
+
+void
+CXLLinkPower::CXLLinkPowerStats::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    power.account(curTick());
+    if (curTick() > power.lastStatsReset) {
+        //              energy (pJ)     1e-9
+        // power (mW) = ----------- * ----------
+        //              time (tick)   tick_frequency
+        averagePower = (totalEnergy.value() /
+                        (curTick() - power.lastStatsReset)) *
+                       (sim_clock::Frequency / 1000000000.0);
+    }
+}
+
+} // namespace gem5
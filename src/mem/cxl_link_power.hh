@@ -0,0 +1,129 @@
+#ifndef __MEM_CXL_LINK_POWER_HH__
+#define __MEM_CXL_LINK_POWER_HH__
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "params/CXLLinkPower.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * Energy of a CXL link and of the controller of the device at its end.
+ *
+ * Every message crossing the link is reported by the device. The link
+ * energy has a dynamic part, a fixed energy per flit, and a static part
+ * that depends on the state of the link. The link is in L0 while it is
+ * used. Once it has been idle for a while it enters L0s and later L1,
+ * where it draws less power. The next message has to wait for the link to
+ * finish entering the state, if it has not yet, and to exit it, so low
+ * power states add latency. The controller spends a fixed energy per
+ * message and draws an idle power all the time.
+ *
+ * Flits are 68 bytes with four 16-byte slots. A message takes a header
+ * slot and a slot for every 16 bytes of data; slots of different messages
+ * share flits, so the flit energy is charged per slot.
+ *
+ * The energy is reported in pJ and the power in mW, as for DRAM, so the
+ * energy per bit of CXL and local memory can be compared directly.
+ */
+class CXLLinkPower : public SimObject
+{
+  public:
+    enum LinkState
+    {
+        L0,
+        L0s,
+        L1,
+        NumLinkStates
+    };
+
+    PARAMS(CXLLinkPower);
+    CXLLinkPower(const Params &p);
+
+    void startup() override;
+
+    /**
+     * A message crosses the link now.
+     *
+     * @param data_bytes Bytes of data the message carries, 0 for none.
+     * @return The time the link needs to get back to L0 first, by which
+     *         the message is delayed.
+     */
+    Tick transfer(unsigned data_bytes);
+
+    /** The state the link is in at the current tick. */
+    LinkState state() const;
+
+  protected:
+    static constexpr unsigned slotBytes = 16;
+    static constexpr unsigned slotsPerFlit = 4;
+
+    /** Idle time before the link starts entering L0s and L1 */
+    const Tick l0sIdle;
+    const Tick l1Idle;
+    /** Time to enter and to exit L0s and L1 */
+    const Tick l0sEntryLat;
+    const Tick l0sExitLat;
+    const Tick l1EntryLat;
+    const Tick l1ExitLat;
+
+    /** Energy per flit and per controller message (pJ) */
+    const double flitEnergy;
+    const double ctrlEnergy;
+    /** Power of the link in each state and of the idle controller (mW) */
+    const double statePower[NumLinkStates];
+    const double ctrlIdlePower;
+
+    /** End of the last use of the link, the start of its idle time */
+    Tick idleSince;
+    /** The link is leaving a low power state until then */
+    Tick wakeDone;
+    /** The static energy is accounted up to then */
+    Tick accountedUntil;
+    Tick lastStatsReset;
+
+    /**
+     * When the link is in L0s and in L1 during the current idle time,
+     * MaxTick for a state it does not reach.
+     */
+    Tick stateStart(LinkState s) const;
+
+    /** Account the static energy and the state times up to a tick */
+    void account(Tick until);
+
+    struct CXLLinkPowerStats : public statistics::Group
+    {
+        CXLLinkPowerStats(CXLLinkPower &power);
+
+        void resetStats() override;
+        void preDumpStats() override;
+
+        CXLLinkPower &power;
+
+        statistics::Vector stateTime;
+        statistics::Vector wakeUps;
+        statistics::Scalar wakeDelay;
+        statistics::Formula avgWakeDelay;
+
+        statistics::Scalar messages;
+        statistics::Scalar slots;
+        statistics::Formula flits;
+        statistics::Scalar dataBytes;
+
+        statistics::Scalar flitEnergy;
+        statistics::Vector stateEnergy;
+        statistics::Scalar ctrlDynEnergy;
+        statistics::Scalar ctrlIdleEnergy;
+        statistics::Scalar totalEnergy;
+        statistics::Formula energyPerBit;
+        statistics::Scalar averagePower;
+    };
+
+    CXLLinkPowerStats stats;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CXL_LINK_POWER_HH__
@@ -0,0 +1,223 @@
+#include "mem/cxl_miss_tracker.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/CXLMissTracker.hh"
+#include "sim/cur_tick.hh"
+#include "sim/stats.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+CXLMissTracker::CXLMissTracker(const Params &p)
+    : SimObject(p), system(p.system), cxlRanges(p.cxl_ranges),
+      maxCXLMLP(p.max_cxl_mlp), occupancyBins(p.occupancy_bins)
+{
+}
+
+int
+CXLMissTracker::registerLevel(const std::string &level_name)
+{
+    // Stat group names cannot contain dots
+    std::string group_name = level_name;
+    std::replace(group_name.begin(), group_name.end(), '.', '_');
+    levels.emplace_back(std::make_unique<Level>(*this, group_name));
+    DPRINTF(CXLMissTracker, "Registered level %d: %s\n",
+            levels.size() - 1, level_name);
+    return levels.size() - 1;
+}
+
+void
+CXLMissTracker::enter(int level, const void *key, Addr addr,
+                      RequestorID requestor)
+{
+    Level &l = *levels[level];
+    Tier t = tier(addr);
+
+    [[maybe_unused]] bool inserted =
+        l.inFlight.emplace(key, InFlight{curTick(), t, requestor}).second;
+    assert(inserted);
+
+    l.accumulate(t);
+    l.arrivalOccupancy[t].sample(l.occupancy[t]);
+    l.occupancy[t]++;
+    if (l.occupancy[t] > l.peak[t]) {
+        l.peak[t] = l.occupancy[t];
+        l.peakOccupancy[t] = l.peak[t];
+    }
+    l.misses[t]++;
+
+    if (t == CXL) {
+        l.requestorCXL[requestor]++;
+        if (requestor < l.requestorCXLMisses.size())
+            l.requestorCXLMisses[requestor]++;
+    }
+
+    DPRINTF(CXLMissTracker, "%s: enter %#x requestor %d, %d outstanding\n",
+            l.levelName, addr, requestor, l.occupancy[t]);
+}
+
+void
+CXLMissTracker::leave(int level, const void *key)
+{
+    Level &l = *levels[level];
+    auto it = l.inFlight.find(key);
+    if (it == l.inFlight.end())
+        return;
+
+    const InFlight &miss = it->second;
+    l.accumulate(miss.tier);
+    assert(l.occupancy[miss.tier] > 0);
+    l.occupancy[miss.tier]--;
+    l.totalLatency[miss.tier] += curTick() - miss.entered;
+
+    if (miss.tier == CXL) {
+        auto req = l.requestorCXL.find(miss.requestor);
+        assert(req != l.requestorCXL.end() && req->second > 0);
+        if (--req->second == 0)
+            l.requestorCXL.erase(req);
+    }
+
+    DPRINTF(CXLMissTracker, "%s: leave after %d ticks, %d outstanding\n",
+            l.levelName, curTick() - miss.entered, l.occupancy[miss.tier]);
+
+    l.inFlight.erase(it);
+}
+
+bool
+CXLMissTracker::mlpLimited(int level, Addr addr, RequestorID requestor)
+{
+    if (maxCXLMLP == 0 || tier(addr) != CXL)
+        return false;
+
+    Level &l = *levels[level];
+    auto it = l.requestorCXL.find(requestor);
+    if (it == l.requestorCXL.end() || it->second < maxCXLMLP)
+        return false;
+
+    DPRINTF(CXLMissTracker, "%s: requestor %d at its CXL MLP limit\n",
+            l.levelName, requestor);
+    if (requestor < l.mlpStalls.size())
+        l.mlpStalls[requestor]++;
+    return true;
+}
+
+CXLMissTracker::Level::Level(CXLMissTracker &_tracker,
+                             const std::string &name)
+    : statistics::Group(&_tracker, name.c_str()),
+      tracker(_tracker), levelName(name),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of misses per tier"),
+      ADD_STAT(arrivalOccupancy, statistics::units::Count::get(),
+               "Misses outstanding per tier, seen by arriving misses"),
+      ADD_STAT(peakOccupancy, statistics::units::Count::get(),
+               "Largest number of misses outstanding per tier"),
+      ADD_STAT(occupancyTicks, statistics::units::Tick::get(),
+               "Misses outstanding per tier integrated over time"),
+      ADD_STAT(avgOccupancy, statistics::units::Count::get(),
+               "Average number of misses outstanding per tier"),
+      ADD_STAT(totalLatency, statistics::units::Tick::get(),
+               "Total time spent at this level by misses per tier"),
+      ADD_STAT(avgLatency, statistics::units::Rate<
+                    statistics::units::Tick, statistics::units::Count>::get(),
+               "Average time spent at this level per miss and tier"),
+      ADD_STAT(missRate, statistics::units::Rate<
+                    statistics::units::Count,
+                    statistics::units::Second>::get(),
+               "Misses per second and tier"),
+      ADD_STAT(requestorCXLMisses, statistics::units::Count::get(),
+               "Number of CXL misses per requestor"),
+      ADD_STAT(mlpStalls, statistics::units::Count::get(),
+               "Number of misses refused per requestor because of the "
+               "CXL MLP limit")
+{
+    occupancy.fill(0);
+    peak.fill(0);
+    lastChange.fill(curTick());
+}
+
+void
+CXLMissTracker::Level::regStats()
+{
+    statistics::Group::regStats();
+
+    using namespace statistics;
+
+    const char *tier_names[NumTiers] = { "local", "cxl" };
+
+    misses.init(NumTiers);
+    arrivalOccupancy
+        .init(NumTiers, 0, tracker.occupancyBins - 1, 1)
+        .flags(nozero);
+    peakOccupancy.init(NumTiers);
+    occupancyTicks.init(NumTiers);
+    avgOccupancy.precision(2);
+    totalLatency.init(NumTiers);
+    avgLatency
+        .flags(nonan)
+        .precision(2);
+    missRate.precision(2);
+
+    for (int t = 0; t < NumTiers; t++) {
+        misses.subname(t, tier_names[t]);
+        arrivalOccupancy.subname(t, tier_names[t]);
+        peakOccupancy.subname(t, tier_names[t]);
+        occupancyTicks.subname(t, tier_names[t]);
+        avgOccupancy.subname(t, tier_names[t]);
+        totalLatency.subname(t, tier_names[t]);
+        avgLatency.subname(t, tier_names[t]);
+        missRate.subname(t, tier_names[t]);
+    }
+
+    // By Little's law, avgOccupancy = missRate * avgLatency
+    avgOccupancy = occupancyTicks / simTicks;
+    avgLatency = totalLatency / misses;
+    missRate = misses / simSeconds;
+
+    const auto max_requestors = tracker.system->maxRequestors();
+    requestorCXLMisses
+        .init(max_requestors)
+        .flags(nozero);
+    mlpStalls
+        .init(max_requestors)
+        .flags(nozero);
+    for (int i = 0; i < max_requestors; i++) {
+        const std::string requestor = tracker.system->getRequestorName(i);
+        requestorCXLMisses.subname(i, requestor);
+        mlpStalls.subname(i, requestor);
+    }
+}
+
+void
+CXLMissTracker::Level::accumulate(Tier t)
+{
+    occupancyTicks[t] += double(occupancy[t]) * (curTick() - lastChange[t]);
+    lastChange[t] = curTick();
+}
+
+void
+CXLMissTracker::Level::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    for (int t = 0; t < NumTiers; t++)
+        accumulate(Tier(t));
+}
+
+void
+CXLMissTracker::Level::resetStats()
+{
+    statistics::Group::resetStats();
+
+    // Start over from the misses that are outstanding right now
+    for (int t = 0; t < NumTiers; t++) {
+        lastChange[t] = curTick();
+        peak[t] = occupancy[t];
+        peakOccupancy[t] = peak[t];
+    }
+}
+
+} // namespace gem5
@@ -0,0 +1,155 @@
+#ifndef __MEM_CXL_MISS_TRACKER_HH__
+#define __MEM_CXL_MISS_TRACKER_HH__
+
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/request.hh"
+#include "params/CXLMissTracker.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class System;
+
+/**
+ * Follows misses along the path to memory: cache MSHRs, the CXLBridge,
+ * the CXLMemory device and the media behind it. Each of these components
+ * registers as a level and reports when a miss enters and leaves it, so
+ * the tracker knows the number of misses outstanding at every level, per
+ * tier (local or CXL memory) and per requestor.
+ *
+ * For every level it records the occupancy seen by arriving misses, the
+ * time-averaged occupancy, the miss rate and the average latency. By
+ * Little's law the time-averaged occupancy is the product of the latter
+ * two, which gives the bandwidth a given MLP can sustain.
+ *
+ * The tracker can also limit the CXL memory-level parallelism of each
+ * requestor, see mlpLimited().
+ */
+class CXLMissTracker : public SimObject
+{
+  public:
+    enum Tier
+    {
+        Local,
+        CXL,
+        NumTiers
+    };
+
+    PARAMS(CXLMissTracker);
+    CXLMissTracker(const Params &p);
+
+    /**
+     * Registers a level of the memory path. Must be called before the
+     * statistics are registered, i.e., from the constructor of the
+     * component.
+     *
+     * @param level_name Name of the component, used for its statistics.
+     * @return Identifier of the level.
+     */
+    int registerLevel(const std::string &level_name);
+
+    /** The memory tier an address belongs to. */
+    Tier
+    tier(Addr addr) const
+    {
+        for (const auto &r : cxlRanges) {
+            if (r.contains(addr))
+                return CXL;
+        }
+        return Local;
+    }
+
+    /**
+     * A miss enters a level.
+     *
+     * @param level Level as returned by registerLevel().
+     * @param key Identifies the miss at this level until it leaves,
+     *            e.g., the packet or the MSHR.
+     * @param addr Address of the miss.
+     * @param requestor Requestor the miss is accounted to.
+     */
+    void enter(int level, const void *key, Addr addr, RequestorID requestor);
+
+    /**
+     * A miss leaves a level. Keys that did not enter the level are
+     * ignored.
+     */
+    void leave(int level, const void *key);
+
+    /**
+     * Checks whether a requestor has reached its limit of outstanding CXL
+     * misses at a level. The level is expected to refuse the miss until
+     * one of the outstanding misses of the requestor has left it.
+     *
+     * @return true if the miss must not enter the level yet.
+     */
+    bool mlpLimited(int level, Addr addr, RequestorID requestor);
+
+    /** Number of misses of a tier outstanding at a level. */
+    unsigned
+    outstanding(int level, Tier t) const
+    {
+        return levels[level]->occupancy[t];
+    }
+
+  private:
+    struct InFlight
+    {
+        Tick entered;
+        Tier tier;
+        RequestorID requestor;
+    };
+
+    struct Level : public statistics::Group
+    {
+        Level(CXLMissTracker &tracker, const std::string &name);
+
+        void regStats() override;
+        void preDumpStats() override;
+        void resetStats() override;
+
+        /** Accounts for the time spent at the current occupancy */
+        void accumulate(Tier t);
+
+        CXLMissTracker &tracker;
+        const std::string levelName;
+
+        std::unordered_map<const void *, InFlight> inFlight;
+        std::array<unsigned, NumTiers> occupancy;
+        std::array<unsigned, NumTiers> peak;
+        std::array<Tick, NumTiers> lastChange;
+        /** Outstanding CXL misses per requestor */
+        std::unordered_map<RequestorID, unsigned> requestorCXL;
+
+        statistics::Vector misses;
+        statistics::VectorDistribution arrivalOccupancy;
+        statistics::Vector peakOccupancy;
+        statistics::Vector occupancyTicks;
+        statistics::Formula avgOccupancy;
+        statistics::Vector totalLatency;
+        statistics::Formula avgLatency;
+        statistics::Formula missRate;
+        statistics::Vector requestorCXLMisses;
+        statistics::Vector mlpStalls;
+    };
+
+    System *system;
+    const std::vector<AddrRange> cxlRanges;
+    const unsigned maxCXLMLP;
+    const unsigned occupancyBins;
+
+    std::vector<std::unique_ptr<Level>> levels;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CXL_MISS_TRACKER_HH__
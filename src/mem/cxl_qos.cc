@@ -0,0 +1,87 @@
+#include "mem/cxl_qos.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "base/str.hh"
+#include "debug/CXLQoS.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+CXLQoS::CXLQoS(const Params &p)
+    : SimObject(p), system(p.system), prefixes(p.requestors),
+      classPriorities(p.requestor_priorities),
+      defaultPriority(p.default_priority),
+      blkSize(p.system->cacheLineSize())
+{
+    fatal_if(p.priorities == 0, "%s: there must be at least one priority",
+             name());
+    fatal_if(prefixes.size() != classPriorities.size(), "%s: requestors "
+             "and requestor_priorities must have the same length", name());
+    for (auto prio : classPriorities) {
+        fatal_if(prio >= p.priorities, "%s: priority %d is out of range, "
+                 "there are %d priorities", name(), prio, p.priorities);
+    }
+    fatal_if(defaultPriority >= p.priorities, "%s: the default priority %d "
+             "is out of range, there are %d priorities", name(),
+             defaultPriority, p.priorities);
+}
+
+void
+CXLQoS::init()
+{
+    // The requestor names do not include the name of the system
+    for (auto &prefix : prefixes) {
+        if (startswith(prefix, system->name() + "."))
+            prefix = prefix.substr(system->name().size() + 1);
+    }
+
+    resolve();
+
+    // Point out the classes that will never see a packet
+    std::vector<bool> matched(prefixes.size(), false);
+    for (RequestorID id = 0; id < system->maxRequestors(); id++) {
+        const std::string name = system->getRequestorName(id);
+        for (size_t i = 0; i < prefixes.size(); i++) {
+            if (name == prefixes[i] || startswith(name, prefixes[i] + "."))
+                matched[i] = true;
+        }
+    }
+    for (size_t i = 0; i < prefixes.size(); i++) {
+        warn_if(!matched[i], "%s: no requestor matches %s", name(),
+                prefixes[i]);
+    }
+}
+
+void
+CXLQoS::resolve()
+{
+    for (RequestorID id = requestorPriority.size();
+         id < system->maxRequestors(); id++) {
+        const std::string name = system->getRequestorName(id);
+        uint8_t prio = defaultPriority;
+        // The first matching prefix wins
+        for (size_t i = 0; i < prefixes.size(); i++) {
+            if (name == prefixes[i] || startswith(name, prefixes[i] + ".")) {
+                prio = classPriorities[i];
+                break;
+            }
+        }
+        DPRINTF(CXLQoS, "Requestor %s [id %d] has priority %d\n", name, id,
+                prio);
+        requestorPriority.push_back(prio);
+    }
+}
+
+uint8_t
+CXLQoS::priority(RequestorID id)
+{
+    if (id >= requestorPriority.size())
+        resolve();
+    if (id >= requestorPriority.size())
+        return defaultPriority;
+    return requestorPriority[id];
+}
+
+} // namespace gem5
@@ -0,0 +1,82 @@
+#ifndef __MEM_CXL_QOS_HH__
+#define __MEM_CXL_QOS_HH__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/cxl_qos_queue.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "params/CXLQoS.hh"
+#include "sim/cur_tick.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class System;
+
+/**
+ * Traffic classes of the CXL path. Each requestor, e.g., the cores of a
+ * tenant, is given a QoS priority. The CXLBridge and the CXLMemory device
+ * tag the packets going to CXL memory with the priority of their
+ * requestor and serve their queues in priority order. The priority stays
+ * with the packet, so a QoS memory controller behind the device without a
+ * policy of its own (e.g., a MemCtrl with qos_priorities set) arbitrates
+ * with it as well.
+ *
+ * Higher values are served first, as in the QoS memory controllers.
+ */
+class CXLQoS : public SimObject
+{
+  public:
+    PARAMS(CXLQoS);
+    CXLQoS(const Params &p);
+
+    void init() override;
+
+    /** The priority of the packets of a requestor. */
+    uint8_t priority(RequestorID id);
+
+    /** Tags a packet with the priority of its requestor. */
+    void
+    tag(PacketPtr pkt)
+    {
+        pkt->qosValue(priority(pkt->requestorId()));
+    }
+
+    /**
+     * The packet of a transmit queue to send next, see cxlQoSNext.
+     *
+     * @param queue A queue of deferred packets, with their tick and pkt.
+     */
+    template <typename Queue>
+    typename Queue::iterator
+    select(Queue &queue) const
+    {
+        return cxlQoSNext(queue, curTick(), blkSize);
+    }
+
+  protected:
+    System *system;
+
+    /** Requestor name prefixes and their priorities */
+    std::vector<std::string> prefixes;
+    const std::vector<uint8_t> classPriorities;
+    const uint8_t defaultPriority;
+
+    /** Packets to the same block keep their order */
+    const unsigned blkSize;
+
+    /** The priority of each requestor id resolved so far */
+    std::vector<uint8_t> requestorPriority;
+
+    /** Resolve the priorities of the requestors registered so far */
+    void resolve();
+};
+
+} // namespace gem5
+
+#endif // __MEM_CXL_QOS_HH__
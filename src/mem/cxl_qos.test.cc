@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <deque>
+
+#include "mem/cxl_qos_queue.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+constexpr unsigned blkSize = 64;
+
+/** The parts of a packet the ordering looks at */
+struct FakePacket
+{
+    uint8_t qos;
+    bool read;
+    Addr addr;
+
+    uint8_t qosValue() const { return qos; }
+    bool isRead() const { return read; }
+    Addr getBlockAddr(unsigned blk_size) const
+    {
+        return addr & ~Addr(blk_size - 1);
+    }
+};
+
+struct Deferred
+{
+    Tick tick;
+    FakePacket *pkt;
+};
+
+/** Index of the packet to send next */
+long
+next(std::deque<Deferred> &queue, Tick now)
+{
+    return cxlQoSNext(queue, now, blkSize) - queue.begin();
+}
+
+} // anonymous namespace
+
+TEST(CXLQoSQueueTest, HighestPriorityFirst)
+{
+    FakePacket a{0, true, 0x0}, b{1, true, 0x40}, c{1, true, 0x80};
+    std::deque<Deferred> queue{{0, &a}, {0, &b}, {0, &c}};
+    // the oldest of the highest priority
+    EXPECT_EQ(next(queue, 0), 1);
+}
+
+TEST(CXLQoSQueueTest, OnlyReadyPackets)
+{
+    FakePacket a{0, true, 0x0}, b{1, true, 0x40};
+    std::deque<Deferred> queue{{0, &a}, {10, &b}};
+    EXPECT_EQ(next(queue, 5), 0);
+    EXPECT_EQ(next(queue, 10), 1);
+}
+
+TEST(CXLQoSQueueTest, HeadWhenNoneReady)
+{
+    FakePacket a{0, true, 0x0}, b{1, true, 0x40};
+    std::deque<Deferred> queue{{10, &a}, {20, &b}};
+    EXPECT_EQ(next(queue, 0), 0);
+}
+
+TEST(CXLQoSQueueTest, ReadDoesNotPassWriteToSameBlock)
+{
+    // a writeback of the line followed by a prioritised read miss to it
+    FakePacket wb{0, false, 0x1000}, rd{1, true, 0x1008};
+    std::deque<Deferred> queue{{0, &wb}, {0, &rd}};
+    EXPECT_EQ(next(queue, 0), 0);
+}
+
+TEST(CXLQoSQueueTest, WriteDoesNotPassReadToSameBlock)
+{
+    FakePacket rd{0, true, 0x1000}, wr{1, false, 0x1020};
+    std::deque<Deferred> queue{{0, &rd}, {0, &wr}};
+    EXPECT_EQ(next(queue, 0), 0);
+}
+
+TEST(CXLQoSQueueTest, WriteDoesNotPassWriteToSameBlock)
+{
+    FakePacket w0{0, false, 0x1000}, w1{1, false, 0x1000};
+    std::deque<Deferred> queue{{0, &w0}, {0, &w1}};
+    EXPECT_EQ(next(queue, 0), 0);
+}
+
+TEST(CXLQoSQueueTest, ReadPassesReadToSameBlock)
+{
+    FakePacket r0{0, true, 0x1000}, r1{1, true, 0x1000};
+    std::deque<Deferred> queue{{0, &r0}, {0, &r1}};
+    EXPECT_EQ(next(queue, 0), 1);
+}
+
+TEST(CXLQoSQueueTest, PassesOtherBlocks)
+{
+    FakePacket wb{0, false, 0x1000}, rd{1, true, 0x1040};
+    std::deque<Deferred> queue{{0, &wb}, {0, &rd}};
+    EXPECT_EQ(next(queue, 0), 1);
+}
+
+TEST(CXLQoSQueueTest, BlockedByWaitingWrite)
+{
+    // the write is not ready yet, the read still has to wait for it
+    FakePacket wr{0, false, 0x1000}, rd{1, true, 0x1000}, other{1, true,
+                                                                0x2000};
+    std::deque<Deferred> queue{{10, &wr}, {0, &rd}, {0, &other}};
+    EXPECT_EQ(next(queue, 5), 2);
+}
+
+TEST(CXLQoSQueueTest, OldestWhenHigherBlocked)
+{
+    // the prioritised read is stuck behind the write, so the packets go
+    // in order
+    FakePacket wr{0, false, 0x1000}, lo{0, true, 0x2000}, hi{1, true,
+                                                             0x1000};
+    std::deque<Deferred> queue{{0, &wr}, {0, &lo}, {0, &hi}};
+    EXPECT_EQ(next(queue, 0), 0);
+}
@@ -0,0 +1,55 @@
+#ifndef __MEM_CXL_QOS_QUEUE_HH__
+#define __MEM_CXL_QOS_QUEUE_HH__
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * The packet of a transmit queue to send next with traffic classes: the
+ * oldest of the highest priority among those ready to go, or the head if
+ * none is.
+ *
+ * A packet never passes an older one to the same block unless both are
+ * reads, so a read cannot overtake a write it depends on, e.g., the
+ * writeback of the line it misses on, and a write cannot overtake a read
+ * that has to see the old data. The queues were strictly in order before
+ * the traffic classes, which is what kept this correct.
+ *
+ * @param queue A queue of deferred packets, with their tick and pkt.
+ * @param now The current tick.
+ * @param blk_size The block size the packets are ordered at.
+ */
+template <typename Queue>
+typename Queue::iterator
+cxlQoSNext(Queue &queue, Tick now, unsigned blk_size)
+{
+    auto best = queue.end();
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+        if (it->tick > now)
+            continue;
+        if (best != queue.end() &&
+            it->pkt->qosValue() <= best->pkt->qosValue()) {
+            continue;
+        }
+
+        // only reads are reordered with older packets to the same block
+        const Addr blk = it->pkt->getBlockAddr(blk_size);
+        bool blocked = false;
+        for (auto older = queue.begin(); older != it; ++older) {
+            if (older->pkt->getBlockAddr(blk_size) == blk &&
+                !(older->pkt->isRead() && it->pkt->isRead())) {
+                blocked = true;
+                break;
+            }
+        }
+        if (!blocked)
+            best = it;
+    }
+    return best == queue.end() ? queue.begin() : best;
+}
+
+} // namespace gem5
+
+#endif // __MEM_CXL_QOS_QUEUE_HH__
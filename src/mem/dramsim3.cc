@@ -38,6 +38,7 @@
 #include "mem/dramsim3.hh"
 
 #include "base/callback.hh"
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/DRAMsim3.hh"
 #include "debug/Drain.hh"
@@ -57,6 +58,8 @@ DRAMsim3::DRAMsim3(const Params &p) :
     write_cb(std::bind(&DRAMsim3::writeComplete,
                        this, 0, std::placeholders::_1)),
     wrapper(p.configFile, p.filePath, read_cb, write_cb),
+    dramPeriod(wrapper.clockPeriod() * sim_clock::as_int::ns),
+    skipIdleCycles(p.skip_idle_cycles), nextCycle(0), needResync(false),
     retryReq(false), retryResp(false), startTick(0),
     nbrOutstandingReads(0), nbrOutstandingWrites(0),
     sendResponseEvent([this]{ sendResponse(); }, name()),
@@ -67,8 +70,13 @@ DRAMsim3::DRAMsim3(const Params &p) :
             wrapper.clockPeriod(), wrapper.queueSize());
 
     // Register a callback to compensate for the destructor not
-    // being called. The callback prints the DRAMsim3 stats.
-    registerExitCallback([this]() { wrapper.printStats(); });
+    // being called. The callback prints the DRAMsim3 stats, including
+    // the idle cycles since the last request.
+    registerExitCallback([this]() {
+        if (!needResync)
+            catchUp();
+        wrapper.printStats();
+    });
 }
 
 void
@@ -92,12 +100,16 @@ DRAMsim3::startup()
 {
     startTick = curTick();
 
-    // kick off the clock ticks
-    schedule(tickEvent, clockEdge());
+    // the clock ticks start with the first request
+    nextCycle = clockEdge();
+    needResync = !system()->isTimingMode();
 }
 
 void
 DRAMsim3::resetStats() {
+    // the idle cycles so far belong to the stats being reset
+    if (!needResync)
+        catchUp();
     wrapper.resetStats();
 }
 
@@ -152,8 +164,46 @@ DRAMsim3::tick()
         }
     }
 
-    schedule(tickEvent,
-        curTick() + wrapper.clockPeriod() * sim_clock::as_int::ns);
+    nextCycle = curTick() + dramPeriod;
+
+    // DRAMsim3 only needs ticking while it has transactions in flight or
+    // a retry to send, the idle cycles are dealt with once the next
+    // request arrives
+    if (nbrOutstandingReads + nbrOutstandingWrites != 0 || retryReq)
+        schedule(tickEvent, nextCycle);
+}
+
+void
+DRAMsim3::catchUp()
+{
+    if (nextCycle >= curTick())
+        return;
+
+    if (skipIdleCycles || needResync) {
+        // stay on the same clock grid
+        nextCycle += divCeil(curTick() - nextCycle, dramPeriod) * dramPeriod;
+    } else {
+        // with nothing in flight the cycles only advance the refresh and
+        // power state of DRAMsim3, so run them back to back rather than
+        // as events
+        DPRINTF(DRAMsim3, "Simulating %d idle cycles\n",
+                divCeil(curTick() - nextCycle, dramPeriod));
+        while (nextCycle < curTick()) {
+            wrapper.tick();
+            nextCycle += dramPeriod;
+        }
+    }
+}
+
+void
+DRAMsim3::wakeUp()
+{
+    if (tickEvent.scheduled())
+        return;
+
+    catchUp();
+    needResync = false;
+    schedule(tickEvent, nextCycle);
 }
 
 Tick
@@ -224,6 +274,9 @@ DRAMsim3::recvTimingReq(PacketPtr pkt)
     }
 
     if (can_accept) {
+        // bring DRAMsim3 up to date before it sees the transaction
+        wakeUp();
+
         // we should never have a situation when we think there is space,
         // and there isn't
         assert(wrapper.canAccept(pkt->getAddr(), pkt->isWrite()));
@@ -238,6 +291,7 @@ DRAMsim3::recvTimingReq(PacketPtr pkt)
         return true;
     } else {
         retryReq = true;
+        wakeUp();
         return false;
     }
 }
@@ -355,6 +409,20 @@ DRAMsim3::drain()
     return nbrOutstanding() != 0 ? DrainState::Draining : DrainState::Drained;
 }
 
+void
+DRAMsim3::drainResume()
+{
+    // DRAMsim3 is not ticked outside the timing mode, finish the cycles of
+    // the timing mode so far and skip the others
+    if (!system()->isTimingMode() && !needResync) {
+        if (tickEvent.scheduled())
+            deschedule(tickEvent);
+        else
+            catchUp();
+        needResync = true;
+    }
+}
+
 DRAMsim3::MemoryPort::MemoryPort(const std::string& _name,
                                  DRAMsim3& _memory)
     : ResponsePort(_name), mem(_memory)
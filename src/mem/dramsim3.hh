@@ -105,6 +105,29 @@ class DRAMsim3 : public AbstractMemory
      */
     DRAMsim3Wrapper wrapper;
 
+    /**
+     * The clock period of DRAMsim3 in ticks
+     */
+    const Tick dramPeriod;
+
+    /**
+     * Skip the idle cycles rather than simulate them when a request
+     * arrives
+     */
+    const bool skipIdleCycles;
+
+    /**
+     * Tick of the next DRAMsim3 cycle, all the cycles before it have
+     * been simulated or skipped
+     */
+    Tick nextCycle;
+
+    /**
+     * DRAMsim3 has not been ticked outside the timing mode, the cycles
+     * since are skipped rather than simulated
+     */
+    bool needResync;
+
     /**
      * Is the connected port waiting for a retry from us
      */
@@ -168,6 +191,17 @@ class DRAMsim3 : public AbstractMemory
      */
     void tick();
 
+    /**
+     * Bring DRAMsim3 up to the current tick, simulating or skipping the
+     * cycles it was not ticked for.
+     */
+    void catchUp();
+
+    /**
+     * Start ticking DRAMsim3 again if it has been idle.
+     */
+    void wakeUp();
+
     /**
      * Event to schedule clock ticks
      */
@@ -203,6 +237,7 @@ class DRAMsim3 : public AbstractMemory
     void writeComplete(unsigned id, uint64_t addr);
 
     DrainState drain() override;
+    void drainResume() override;
 
     virtual Port& getPort(const std::string& if_name,
                           PortID idx = InvalidPortID) override;
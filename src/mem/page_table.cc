@@ -44,6 +44,31 @@
 namespace gem5
 {
 
+int
+EmulationPageTable::mapLevel(Addr vaddr, Addr paddr, int64_t size) const
+{
+    if (!hugePages)
+        return 0;
+    for (int level = PTable::numLevels - 1; level > 0; level--) {
+        Addr bytes = Addr(1) << pTable.levelShift(level);
+        if (size >= (int64_t)bytes && ((vaddr | paddr) & (bytes - 1)) == 0)
+            return level;
+    }
+    return 0;
+}
+
+void
+EmulationPageTable::split(Addr vaddr, int level)
+{
+    DPRINTF(MMU, "Splitting huge page: %#x-%#x\n", vaddr,
+            vaddr + (Addr(1) << pTable.levelShift(level)));
+
+    const unsigned shift = pTable.levelShift(level - 1);
+    pTable.split(vaddr, level, [shift](const Entry &entry, unsigned i) {
+        return Entry(entry.paddr + (Addr(i) << shift), entry.flags, shift);
+    });
+}
+
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
@@ -54,20 +79,22 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
     while (size > 0) {
-        auto it = pTable.find(vaddr);
-        if (it != pTable.end()) {
+        const int level = mapLevel(vaddr, paddr, size);
+        const Addr bytes = Addr(1) << pTable.levelShift(level);
+        if (!EmulationPageTable::isUnmapped(vaddr, bytes)) {
             // already mapped
             panic_if(!clobber,
                      "EmulationPageTable::allocate: addr %#x already mapped",
                      vaddr);
-            it->second = Entry(paddr, flags);
-        } else {
-            pTable.emplace(vaddr, Entry(paddr, flags));
+            // The range may be mapped only in part
+            unmapRange(vaddr, bytes, true);
         }
+        pTable.insert(vaddr, level,
+                      Entry(paddr, flags, pTable.levelShift(level)));
 
-        size -= _pageSize;
-        vaddr += _pageSize;
-        paddr += _pageSize;
+        size -= bytes;
+        vaddr += bytes;
+        paddr += bytes;
     }
 }
 
@@ -81,23 +108,67 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
             new_vaddr, size);
 
     while (size > 0) {
-        [[maybe_unused]] auto new_it = pTable.find(new_vaddr);
-        auto old_it = pTable.find(vaddr);
-        assert(old_it != pTable.end() && new_it == pTable.end());
-
-        pTable.emplace(new_vaddr, old_it->second);
-        pTable.erase(old_it);
-        size -= _pageSize;
-        vaddr += _pageSize;
-        new_vaddr += _pageSize;
+        int level;
+        const Entry *entry = pTable.find(vaddr, level);
+        panic_if(!entry, "EmulationPageTable::remap: addr %#x not mapped",
+                 vaddr);
+
+        // Huge pages only move as a whole
+        const Addr bytes = Addr(1) << pTable.levelShift(level);
+        if (((vaddr | new_vaddr) & (bytes - 1)) || size < (int64_t)bytes) {
+            split(roundDown(vaddr, bytes), level);
+            continue;
+        }
+
+        assert(EmulationPageTable::isUnmapped(new_vaddr, bytes));
+        const Entry moved = *entry;
+        pTable.erase(vaddr, level);
+        pTable.insert(new_vaddr, level, moved);
+
+        size -= bytes;
+        vaddr += bytes;
+        new_vaddr += bytes;
     }
 }
 
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
-    for (auto &iter : pTable)
-        addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
+    pTable.forEach([&](Addr vaddr, int, const Entry &entry) {
+        const Addr bytes = Addr(1) << entry.logBytes;
+        for (Addr offset = 0; offset < bytes; offset += _pageSize) {
+            addr_maps->push_back(
+                    std::make_pair(vaddr + offset, entry.paddr + offset));
+        }
+    });
+}
+
+void
+EmulationPageTable::unmapRange(Addr vaddr, int64_t size, bool partial)
+{
+    while (size > 0) {
+        int level;
+        const Entry *entry = pTable.find(vaddr, level);
+        const Addr bytes = Addr(1) << pTable.levelShift(level);
+        if (!entry) {
+            panic_if(!partial,
+                     "EmulationPageTable::unmap: addr %#x not mapped", vaddr);
+            // Skip the whole unmapped block containing vaddr
+            const Addr next = roundDown(vaddr, bytes) + bytes;
+            size -= next - vaddr;
+            vaddr = next;
+            continue;
+        }
+
+        if ((vaddr & (bytes - 1)) || size < (int64_t)bytes) {
+            split(roundDown(vaddr, bytes), level);
+            continue;
+        }
+        pTable.erase(vaddr, level);
+
+        size -= bytes;
+        vaddr += bytes;
+    }
 }
 
 void
@@ -107,13 +178,7 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
-    while (size > 0) {
-        auto it = pTable.find(vaddr);
-        assert(it != pTable.end());
-        pTable.erase(it);
-        size -= _pageSize;
-        vaddr += _pageSize;
-    }
+    unmapRange(vaddr, size);
 }
 
 bool
@@ -122,9 +187,16 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
-    for (int64_t offset = 0; offset < size; offset += _pageSize)
-        if (pTable.find(vaddr + offset) != pTable.end())
+    while (size > 0) {
+        int level;
+        if (pTable.find(vaddr, level))
             return false;
+        // Skip the whole unmapped block containing vaddr
+        const Addr bytes = Addr(1) << pTable.levelShift(level);
+        const Addr next = roundDown(vaddr, bytes) + bytes;
+        size -= next - vaddr;
+        vaddr = next;
+    }
 
     return true;
 }
@@ -132,11 +204,8 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
 const EmulationPageTable::Entry *
 EmulationPageTable::lookup(Addr vaddr)
 {
-    Addr page_addr = pageAlign(vaddr);
-    PTableItr iter = pTable.find(page_addr);
-    if (iter == pTable.end())
-        return nullptr;
-    return &(iter->second);
+    int level;
+    return pTable.find(vaddr, level);
 }
 
 bool
@@ -147,7 +216,7 @@ EmulationPageTable::translate(Addr vaddr, Addr &paddr)
         DPRINTF(MMU, "Couldn't Translate: %#x\n", vaddr);
         return false;
     }
-    paddr = pageOffset(vaddr) + entry->paddr;
+    paddr = entry->translate(vaddr);
     DPRINTF(MMU, "Translating: %#x->%#x\n", vaddr, paddr);
     return true;
 }
@@ -171,14 +240,20 @@ EmulationPageTable::translate(const RequestPtr &req)
 void
 EmulationPageTable::PageTableTranslationGen::translate(Range &range) const
 {
-    const Addr page_size = pt->pageSize();
+    const Entry *entry = pt->lookup(range.vaddr);
+    // Huge pages are physically contiguous, so a single range can extend
+    // to the end of the mapping
+    const Addr page_size =
+        entry ? Addr(1) << entry->logBytes : pt->pageSize();
 
     Addr next = roundUp(range.vaddr, page_size);
     if (next == range.vaddr)
         next += page_size;
     range.size = std::min(range.size, next - range.vaddr);
 
-    if (!pt->translate(range.vaddr, range.paddr))
+    if (entry)
+        range.paddr = entry->translate(range.vaddr);
+    else
         range.fault = Fault(new GenericPageTableFault(range.vaddr));
 }
 
@@ -188,14 +263,18 @@ EmulationPageTable::serialize(CheckpointOut &cp) const
     ScopedCheckpointSection sec(cp, "ptable");
     paramOut(cp, "size", pTable.size());
 
-    PTable::size_type count = 0;
-    for (auto &pte : pTable) {
+    std::size_t count = 0;
+    pTable.forEach([&](Addr vaddr, int, const Entry &entry) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", count++));
 
-        paramOut(cp, "vaddr", pte.first);
-        paramOut(cp, "paddr", pte.second.paddr);
-        paramOut(cp, "flags", pte.second.flags);
-    }
+        paramOut(cp, "vaddr", vaddr);
+        paramOut(cp, "paddr", entry.paddr);
+        paramOut(cp, "flags", entry.flags);
+        // Base pages are stored as before, so that checkpoints without
+        // huge pages do not change
+        if (Addr(1) << entry.logBytes != _pageSize)
+            paramOut(cp, "log_bytes", entry.logBytes);
+    });
     assert(count == pTable.size());
 }
 
@@ -206,6 +285,7 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
     ScopedCheckpointSection sec(cp, "ptable");
     paramIn(cp, "size", count);
 
+    const unsigned page_shift = floorLog2(_pageSize);
     for (int i = 0; i < count; ++i) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", i));
 
@@ -215,8 +295,16 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
         uint64_t flags;
         UNSERIALIZE_SCALAR(paddr);
         UNSERIALIZE_SCALAR(flags);
-
-        pTable.emplace(vaddr, Entry(paddr, flags));
+        // Older checkpoints only have base pages
+        unsigned log_bytes = page_shift;
+        optParamIn(cp, "log_bytes", log_bytes, false);
+
+        const int level = (log_bytes - page_shift) / PTable::levelBits;
+        fatal_if(level >= PTable::numLevels ||
+                 pTable.levelShift(level) != log_bytes,
+                 "Invalid page table mapping size %#x at %#x.",
+                 Addr(1) << log_bytes, vaddr);
+        pTable.insert(vaddr, level, Entry(paddr, flags, log_bytes));
     }
 }
 
@@ -224,9 +312,13 @@ const std::string
 EmulationPageTable::externalize() const
 {
     std::stringstream ss;
-    for (PTable::const_iterator it=pTable.begin(); it != pTable.end(); ++it) {
-        ss << std::hex << it->first << ":" << it->second.paddr << ";";
-    }
+    pTable.forEach([&](Addr vaddr, int, const Entry &entry) {
+        const Addr bytes = Addr(1) << entry.logBytes;
+        for (Addr offset = 0; offset < bytes; offset += _pageSize) {
+            ss << std::hex << vaddr + offset << ":" << entry.paddr + offset
+               << ";";
+        }
+    });
     return ss.str();
 }
 
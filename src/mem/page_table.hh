@@ -36,11 +36,11 @@
 #define __MEM_PAGE_TABLE_HH__
 
 #include <string>
-#include <unordered_map>
 
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base/types.hh"
+#include "mem/radix_page_map.hh"
 #include "mem/request.hh"
 #include "mem/translation_gen.hh"
 #include "sim/serialize.hh"
@@ -57,14 +57,25 @@ class EmulationPageTable : public Serializable
     {
         Addr paddr;
         uint64_t flags;
+        // log2 of the size of the mapping, which is larger than the page
+        // size for huge pages. paddr is the start of the mapping.
+        unsigned logBytes;
 
-        Entry(Addr paddr, uint64_t flags) : paddr(paddr), flags(flags) {}
+        Entry(Addr paddr, uint64_t flags, unsigned log_bytes) :
+            paddr(paddr), flags(flags), logBytes(log_bytes)
+        {}
         Entry() {}
+
+        /** Physical address of vaddr, which must be in this mapping. */
+        Addr
+        translate(Addr vaddr) const
+        {
+            return paddr + (vaddr & mask(logBytes));
+        }
     };
 
   protected:
-    typedef std::unordered_map<Addr, Entry> PTable;
-    typedef PTable::iterator PTableItr;
+    typedef RadixPageMap<Entry> PTable;
     PTable pTable;
 
     const Addr _pageSize;
@@ -73,12 +84,16 @@ class EmulationPageTable : public Serializable
     const uint64_t _pid;
     const std::string _name;
 
+    // Whether map() may use huge page entries
+    bool hugePages;
+
   public:
 
     EmulationPageTable(
             const std::string &__name, uint64_t _pid, Addr _pageSize) :
-            _pageSize(_pageSize), offsetMask(mask(floorLog2(_pageSize))),
-            _pid(_pid), _name(__name), shared(false)
+            pTable(floorLog2(_pageSize)), _pageSize(_pageSize),
+            offsetMask(mask(floorLog2(_pageSize))),
+            _pid(_pid), _name(__name), hugePages(false), shared(false)
     {
         assert(isPowerOf2(_pageSize));
     }
@@ -103,6 +118,12 @@ class EmulationPageTable : public Serializable
     // flag which marks the page table as shared among software threads
     bool shared;
 
+    /**
+     * Allow map() to use huge page entries, see Process::hugePages.
+     * Otherwise every base page gets an entry of its own.
+     */
+    void setHugePages(bool enable) { hugePages = enable; }
+
     virtual void initState() {};
 
     // for DPRINTF compatibility
@@ -110,12 +131,26 @@ class EmulationPageTable : public Serializable
 
     Addr pageAlign(Addr a)  { return (a & ~offsetMask); }
     Addr pageOffset(Addr a) { return (a &  offsetMask); }
-    // Page size can technically vary based on the virtual address, but we'll
-    // ignore that for now.
+    // Base page size. Mappings of huge pages are larger, see
+    // hugePageSize() and Entry::logBytes.
     Addr pageSize()   { return _pageSize; }
 
     /**
-     * Maps a virtual memory region to a physical memory region.
+     * Size of the huge pages at the given level, i.e. 512 (level 1) or
+     * 512^2 (level 2) base pages. With 4KiB pages, these are the 2MiB and
+     * 1GiB pages of x86-64.
+     */
+    Addr
+    hugePageSize(int level = 1)
+    {
+        return Addr(1) << pTable.levelShift(level);
+    }
+
+    /**
+     * Maps a virtual memory region to a physical memory region. With huge
+     * pages enabled, parts of the region where the virtual and physical
+     * addresses are both aligned to a huge page size are mapped with huge
+     * pages. Unmapping or remapping part of a huge page splits it.
      * @param vaddr The starting virtual address of the region.
      * @param paddr The starting physical address where the region is mapped.
      * @param size The length of the region.
@@ -137,7 +172,9 @@ class EmulationPageTable : public Serializable
     /**
      * Lookup function
      * @param vaddr The virtual address.
-     * @return The page table entry corresponding to vaddr.
+     * @return The page table entry corresponding to vaddr, which may map
+     *         a huge page. Use Entry::translate() to get the physical
+     *         address of vaddr or of its base page.
      */
     const Entry *lookup(Addr vaddr);
 
@@ -189,15 +226,42 @@ class EmulationPageTable : public Serializable
     Fault translate(const RequestPtr &req);
 
     /**
-     * Dump all items in the pTable, to a concatenation of strings of the form
+     * Dump all mappings in the pTable, to a concatenation of strings of the
+     * form
      *    Addr:Entry;
+     * with one string per base page.
      */
     const std::string externalize() const;
 
+    /**
+     * Get the (vaddr, paddr) pairs of all mapped base pages, with huge
+     * pages broken up into base pages.
+     */
     void getMappings(std::vector<std::pair<Addr, Addr>> *addr_mappings);
 
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
+
+  private:
+    /**
+     * Returns the largest level at which a mapping of vaddr to paddr
+     * fits in size bytes, or the base page level without huge pages.
+     */
+    int mapLevel(Addr vaddr, Addr paddr, int64_t size) const;
+
+    /**
+     * Splits the mapping at vaddr of the given level into mappings of
+     * the level below.
+     */
+    void split(Addr vaddr, int level);
+
+    /**
+     * Removes all mappings in a range, splitting huge pages as needed.
+     *
+     * @param partial Skip the unmapped parts of the range rather than
+     *                panic on them.
+     */
+    void unmapRange(Addr vaddr, int64_t size, bool partial=false);
 };
 
 } // namespace gem5
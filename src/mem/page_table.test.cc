@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+#include "mem/page_table.hh"
+#include "sim/faults.hh"
+
+using namespace gem5;
+
+// The page table creates faults, which are never invoked here
+void FaultBase::invoke(ThreadContext *, const StaticInstPtr &) {}
+void GenericPageTableFault::invoke(ThreadContext *, const StaticInstPtr &) {}
+
+namespace
+{
+
+constexpr Addr pageBytes = 0x1000;
+constexpr Addr hugeBytes = 0x200000;
+
+} // anonymous namespace
+
+TEST(EmulationPageTableTest, BasePagesByDefault)
+{
+    EmulationPageTable pt("pt", 0, pageBytes);
+    pt.map(hugeBytes, 4 * hugeBytes, hugeBytes);
+
+    const auto *entry = pt.lookup(hugeBytes + 3 * pageBytes);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(Addr(1) << entry->logBytes, pageBytes);
+    EXPECT_EQ(entry->translate(hugeBytes + 3 * pageBytes),
+              4 * hugeBytes + 3 * pageBytes);
+}
+
+TEST(EmulationPageTableTest, ExternalizesBasePages)
+{
+    EmulationPageTable pt("pt", 0, pageBytes);
+    pt.setHugePages(true);
+    pt.map(hugeBytes, 4 * hugeBytes, hugeBytes);
+
+    const std::string mappings = pt.externalize();
+    EXPECT_EQ(std::count(mappings.begin(), mappings.end(), ';'),
+              hugeBytes / pageBytes);
+    EXPECT_EQ(mappings.substr(0, 28), "200000:800000;201000:801000;");
+}
+
+TEST(EmulationPageTableTest, MapsHugePages)
+{
+    EmulationPageTable pt("pt", 0, pageBytes);
+    pt.setHugePages(true);
+    pt.map(hugeBytes, 4 * hugeBytes, hugeBytes);
+
+    const auto *entry = pt.lookup(hugeBytes + 3 * pageBytes);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(Addr(1) << entry->logBytes, hugeBytes);
+    EXPECT_EQ(entry->translate(hugeBytes + 3 * pageBytes),
+              4 * hugeBytes + 3 * pageBytes);
+}
+
+TEST(EmulationPageTableTest, ClobberPartlyMapped)
+{
+    EmulationPageTable pt("pt", 0, pageBytes);
+    pt.setHugePages(true);
+    // a few base pages inside a huge page aligned range
+    pt.map(hugeBytes + pageBytes, 0x10000, 2 * pageBytes);
+    pt.map(2 * hugeBytes - pageBytes, 0x20000, pageBytes);
+
+    // a huge page sized clobber of the whole range
+    pt.map(hugeBytes, 4 * hugeBytes, hugeBytes, EmulationPageTable::Clobber);
+
+    for (Addr offset = 0; offset < hugeBytes; offset += pageBytes) {
+        Addr paddr;
+        ASSERT_TRUE(pt.translate(hugeBytes + offset, paddr));
+        EXPECT_EQ(paddr, 4 * hugeBytes + offset);
+    }
+    const auto *entry = pt.lookup(hugeBytes);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(Addr(1) << entry->logBytes, hugeBytes);
+    EXPECT_TRUE(pt.isUnmapped(0, hugeBytes));
+    EXPECT_TRUE(pt.isUnmapped(2 * hugeBytes, hugeBytes));
+}
+
+TEST(EmulationPageTableTest, ClobberPartOfHugePage)
+{
+    EmulationPageTable pt("pt", 0, pageBytes);
+    pt.setHugePages(true);
+    pt.map(hugeBytes, 4 * hugeBytes, hugeBytes);
+
+    // base pages over the middle of the huge page and past its end
+    const Addr vaddr = 2 * hugeBytes - 2 * pageBytes;
+    pt.map(vaddr, 0x10000, 4 * pageBytes, EmulationPageTable::Clobber);
+
+    Addr paddr;
+    ASSERT_TRUE(pt.translate(hugeBytes, paddr));
+    EXPECT_EQ(paddr, 4 * hugeBytes);
+    for (Addr offset = 0; offset < 4 * pageBytes; offset += pageBytes) {
+        ASSERT_TRUE(pt.translate(vaddr + offset, paddr));
+        EXPECT_EQ(paddr, 0x10000 + offset);
+    }
+    EXPECT_TRUE(pt.isUnmapped(vaddr + 4 * pageBytes, pageBytes));
+}
+
+TEST(EmulationPageTableTest, ClobberUnmapped)
+{
+    EmulationPageTable pt("pt", 0, pageBytes);
+    pt.setHugePages(true);
+    pt.map(0, 0, 2 * hugeBytes, EmulationPageTable::Clobber);
+
+    Addr paddr;
+    ASSERT_TRUE(pt.translate(hugeBytes + pageBytes, paddr));
+    EXPECT_EQ(paddr, hugeBytes + pageBytes);
+}
+
+TEST(EmulationPageTableDeathTest, MapOverMapped)
+{
+    EmulationPageTable pt("pt", 0, pageBytes);
+    pt.setHugePages(true);
+    pt.map(hugeBytes + pageBytes, 0x10000, pageBytes);
+    EXPECT_ANY_THROW(pt.map(hugeBytes, 0, hugeBytes));
+}
@@ -0,0 +1,275 @@
+#ifndef __MEM_RADIX_PAGE_MAP_HH__
+#define __MEM_RADIX_PAGE_MAP_HH__
+
+#include <array>
+#include <bitset>
+#include <cassert>
+#include <cstddef>
+#include <map>
+#include <memory>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Host-side storage for the mappings of an emulated page table. Like the
+ * radix tree of MultiLevelPageTable, virtual addresses are split into
+ * 9-bit indices above the page offset, but the tree lives in simulator
+ * memory and its leaves can be found at three levels:
+ *
+ *  - level 0 maps a single page (4KiB with 4KiB pages)
+ *  - level 1 maps 2^9 pages (2MiB)
+ *  - level 2 maps 2^18 pages (1GiB)
+ *
+ * Level-2 regions are kept in a sorted map, which has a handful of
+ * entries even for very large footprints. Each region either holds a
+ * level-2 mapping or a flat table of 512 slots, and each slot either
+ * holds a level-1 mapping or a flat table of 512 level-0 values. A lookup
+ * is thus one search among the regions plus at most two array accesses,
+ * and mapping a large region allocates a single table per 2MiB at most.
+ *
+ * Mappings are inserted and erased at their own level; callers split a
+ * larger mapping into the next level down to change part of it.
+ */
+template <typename T>
+class RadixPageMap
+{
+  public:
+    static constexpr unsigned levelBits = 9;
+    static constexpr unsigned fanout = 1 << levelBits;
+    static constexpr int numLevels = 3;
+
+    explicit RadixPageMap(unsigned page_shift)
+        : pageShift(page_shift), _size(0)
+    {}
+
+    /** log2 of the number of bytes mapped by a mapping at this level */
+    unsigned
+    levelShift(int level) const
+    {
+        return pageShift + level * levelBits;
+    }
+
+    /** Number of mappings, regardless of their level */
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    /**
+     * Finds the mapping that contains vaddr.
+     * @param level Set to the level of the mapping on a hit. On a miss,
+     *              set to the level of the largest unmapped aligned
+     *              block that contains vaddr, i.e. the range
+     *              [roundDown(vaddr, 1 << levelShift(level)), +that)
+     *              has no mappings.
+     * @return The mapped value or nullptr.
+     */
+    const T *
+    find(Addr vaddr, int &level) const
+    {
+        auto it = regions.find(vaddr >> levelShift(2));
+        if (it == regions.end()) {
+            level = 2;
+            return nullptr;
+        }
+        const Region &r = it->second;
+        if (r.mapped) {
+            level = 2;
+            return &r.val;
+        }
+        const Slot &s = r.dir->slots[index(vaddr, 1)];
+        level = 1;
+        if (s.mapped)
+            return &s.val;
+        if (!s.leaf)
+            return nullptr;
+        unsigned i = index(vaddr, 0);
+        level = 0;
+        return s.leaf->valid[i] ? &s.leaf->vals[i] : nullptr;
+    }
+
+    T *
+    find(Addr vaddr, int &level)
+    {
+        return const_cast<T *>(
+                static_cast<const RadixPageMap *>(this)->find(vaddr, level));
+    }
+
+    /**
+     * Adds a mapping of 1 << levelShift(level) bytes at vaddr, which must
+     * be aligned to that size. The range must not overlap any mapping.
+     */
+    void
+    insert(Addr vaddr, int level, const T &val)
+    {
+        assert(level >= 0 && level < numLevels);
+        assert((vaddr & ((Addr(1) << levelShift(level)) - 1)) == 0);
+
+        Region &r = regions[vaddr >> levelShift(2)];
+        assert(!r.mapped);
+        if (level == 2) {
+            assert(!r.dir);
+            r.val = val;
+            r.mapped = true;
+        } else {
+            if (!r.dir)
+                r.dir = std::make_unique<Dir>();
+            Slot &s = r.dir->slots[index(vaddr, 1)];
+            assert(!s.mapped);
+            if (level == 1) {
+                assert(!s.leaf);
+                s.val = val;
+                s.mapped = true;
+                r.dir->used++;
+            } else {
+                if (!s.leaf) {
+                    s.leaf = std::make_unique<Leaf>();
+                    r.dir->used++;
+                }
+                unsigned i = index(vaddr, 0);
+                assert(!s.leaf->valid[i]);
+                s.leaf->vals[i] = val;
+                s.leaf->valid[i] = true;
+            }
+        }
+        _size++;
+    }
+
+    /**
+     * Removes the mapping at vaddr, which must have been inserted at that
+     * address and level. Tables left empty are freed.
+     */
+    void
+    erase(Addr vaddr, int level)
+    {
+        assert(level >= 0 && level < numLevels);
+        auto it = regions.find(vaddr >> levelShift(2));
+        assert(it != regions.end());
+        Region &r = it->second;
+        if (level == 2) {
+            assert(r.mapped);
+            regions.erase(it);
+        } else {
+            assert(r.dir);
+            Slot &s = r.dir->slots[index(vaddr, 1)];
+            if (level == 1) {
+                assert(s.mapped);
+                s.mapped = false;
+                r.dir->used--;
+            } else {
+                unsigned i = index(vaddr, 0);
+                assert(s.leaf && s.leaf->valid[i]);
+                s.leaf->valid[i] = false;
+                if (s.leaf->valid.none()) {
+                    s.leaf.reset();
+                    r.dir->used--;
+                }
+            }
+            if (r.dir->used == 0)
+                regions.erase(it);
+        }
+        assert(_size > 0);
+        _size--;
+    }
+
+    /**
+     * Replaces the mapping at vaddr, inserted at the given level, with
+     * fanout mappings at the level below. The i-th new mapping gets the
+     * value f(val, i), where val is the value of the original mapping.
+     */
+    template <typename F>
+    void
+    split(Addr vaddr, int level, F f)
+    {
+        assert(level > 0);
+        int found;
+        const T *v = find(vaddr, found);
+        assert(v && found == level);
+        T val = *v;
+        erase(vaddr, level);
+        for (unsigned i = 0; i < fanout; i++)
+            insert(vaddr + (Addr(i) << levelShift(level - 1)), level - 1,
+                   f(val, i));
+    }
+
+    /**
+     * Calls f(vaddr, level, val) on every mapping, in ascending order of
+     * virtual address.
+     */
+    template <typename F>
+    void
+    forEach(F f) const
+    {
+        for (const auto &[key, r] : regions) {
+            Addr base = key << levelShift(2);
+            if (r.mapped) {
+                f(base, 2, r.val);
+                continue;
+            }
+            for (unsigned j = 0; j < fanout; j++) {
+                const Slot &s = r.dir->slots[j];
+                Addr slot_base = base + (Addr(j) << levelShift(1));
+                if (s.mapped) {
+                    f(slot_base, 1, s.val);
+                } else if (s.leaf) {
+                    for (unsigned i = 0; i < fanout; i++) {
+                        if (s.leaf->valid[i]) {
+                            f(slot_base + (Addr(i) << pageShift), 0,
+                              s.leaf->vals[i]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void
+    clear()
+    {
+        regions.clear();
+        _size = 0;
+    }
+
+  private:
+    unsigned
+    index(Addr vaddr, int level) const
+    {
+        return (vaddr >> levelShift(level)) & (fanout - 1);
+    }
+
+    struct Leaf
+    {
+        std::array<T, fanout> vals;
+        std::bitset<fanout> valid;
+    };
+
+    struct Slot
+    {
+        T val;
+        bool mapped = false;
+        std::unique_ptr<Leaf> leaf;
+    };
+
+    struct Dir
+    {
+        std::array<Slot, fanout> slots;
+        // Slots holding a mapping or a leaf table
+        unsigned used = 0;
+    };
+
+    struct Region
+    {
+        T val;
+        bool mapped = false;
+        std::unique_ptr<Dir> dir;
+    };
+
+    const unsigned pageShift;
+    std::map<Addr, Region> regions;
+    std::size_t _size;
+};
+
+} // namespace gem5
+
+#endif // __MEM_RADIX_PAGE_MAP_HH__
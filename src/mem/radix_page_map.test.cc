@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "mem/radix_page_map.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+constexpr unsigned pageShift = 12;
+constexpr Addr pageBytes = Addr(1) << pageShift;
+constexpr Addr hugeBytes = Addr(1) << 21;
+constexpr Addr gigaBytes = Addr(1) << 30;
+
+struct Mapping
+{
+    Addr vaddr;
+    int level;
+    int val;
+};
+
+std::vector<Mapping>
+mappings(const RadixPageMap<int> &map)
+{
+    std::vector<Mapping> all;
+    map.forEach([&](Addr vaddr, int level, int val) {
+        all.push_back({vaddr, level, val});
+    });
+    return all;
+}
+
+} // anonymous namespace
+
+TEST(RadixPageMapTest, LevelShifts)
+{
+    RadixPageMap<int> map(pageShift);
+    EXPECT_EQ(map.levelShift(0), 12u);
+    EXPECT_EQ(map.levelShift(1), 21u);
+    EXPECT_EQ(map.levelShift(2), 30u);
+}
+
+TEST(RadixPageMapTest, Empty)
+{
+    RadixPageMap<int> map(pageShift);
+    int level = -1;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(0x1000, level), nullptr);
+    // Nothing is mapped in the whole 1GiB block
+    EXPECT_EQ(level, 2);
+}
+
+TEST(RadixPageMapTest, FindAtEachLevel)
+{
+    RadixPageMap<int> map(pageShift);
+    map.insert(0x1000, 0, 1);
+    map.insert(hugeBytes * 3, 1, 2);
+    map.insert(gigaBytes * 5, 2, 3);
+    EXPECT_EQ(map.size(), 3u);
+
+    int level;
+    ASSERT_NE(map.find(0x1fff, level), nullptr);
+    EXPECT_EQ(*map.find(0x1fff, level), 1);
+    EXPECT_EQ(level, 0);
+
+    ASSERT_NE(map.find(hugeBytes * 3 + 0x12345, level), nullptr);
+    EXPECT_EQ(*map.find(hugeBytes * 3 + 0x12345, level), 2);
+    EXPECT_EQ(level, 1);
+
+    ASSERT_NE(map.find(gigaBytes * 6 - 1, level), nullptr);
+    EXPECT_EQ(*map.find(gigaBytes * 6 - 1, level), 3);
+    EXPECT_EQ(level, 2);
+
+    // Misses report the largest unmapped block around the address
+    EXPECT_EQ(map.find(0x2000, level), nullptr);
+    EXPECT_EQ(level, 0);
+    EXPECT_EQ(map.find(hugeBytes * 4, level), nullptr);
+    EXPECT_EQ(level, 1);
+    EXPECT_EQ(map.find(gigaBytes * 7, level), nullptr);
+    EXPECT_EQ(level, 2);
+}
+
+TEST(RadixPageMapTest, EraseFreesTables)
+{
+    RadixPageMap<int> map(pageShift);
+    map.insert(0x1000, 0, 1);
+    map.insert(0x2000, 0, 2);
+    map.erase(0x1000, 0);
+
+    int level;
+    EXPECT_EQ(map.find(0x1000, level), nullptr);
+    EXPECT_EQ(level, 0);
+    map.erase(0x2000, 0);
+    EXPECT_TRUE(map.empty());
+    // The leaf and directory tables are gone
+    EXPECT_EQ(map.find(0x2000, level), nullptr);
+    EXPECT_EQ(level, 2);
+
+    // The freed range can be mapped at a higher level
+    map.insert(0, 1, 3);
+    EXPECT_EQ(*map.find(0x2000, level), 3);
+    EXPECT_EQ(level, 1);
+}
+
+TEST(RadixPageMapTest, Split)
+{
+    RadixPageMap<int> map(pageShift);
+    map.insert(gigaBytes, 2, 0);
+    map.split(gigaBytes, 2, [](int val, unsigned i) { return val + i; });
+    EXPECT_EQ(map.size(), 512u);
+
+    int level;
+    EXPECT_EQ(*map.find(gigaBytes + hugeBytes * 7 + 0x10, level), 7);
+    EXPECT_EQ(level, 1);
+
+    map.split(gigaBytes + hugeBytes * 7, 1,
+              [](int val, unsigned i) { return val * 1000 + i; });
+    EXPECT_EQ(map.size(), 511u + 512u);
+    EXPECT_EQ(*map.find(gigaBytes + hugeBytes * 7 + pageBytes * 9, level),
+              7009);
+    EXPECT_EQ(level, 0);
+}
+
+TEST(RadixPageMapTest, ForEachInOrder)
+{
+    RadixPageMap<int> map(pageShift);
+    map.insert(gigaBytes * 2, 2, 4);
+    map.insert(hugeBytes, 1, 2);
+    map.insert(hugeBytes * 2 + pageBytes, 0, 3);
+    map.insert(pageBytes, 0, 1);
+
+    auto all = mappings(map);
+    ASSERT_EQ(all.size(), 4u);
+    EXPECT_EQ(all[0].vaddr, pageBytes);
+    EXPECT_EQ(all[1].vaddr, hugeBytes);
+    EXPECT_EQ(all[1].level, 1);
+    EXPECT_EQ(all[2].vaddr, hugeBytes * 2 + pageBytes);
+    EXPECT_EQ(all[3].vaddr, gigaBytes * 2);
+    EXPECT_EQ(all[3].level, 2);
+    for (int i = 0; i < 4; i++)
+        EXPECT_EQ(all[i].val, i + 1);
+}
+
+// Random base page mappings checked against a hash map, as used by the
+// emulated page tables before
+TEST(RadixPageMapTest, MatchesReference)
+{
+    std::mt19937_64 rng(0);
+    // A few sparse 1GiB regions with dense pages in them
+    std::uniform_int_distribution<Addr> region(0, 7);
+    std::uniform_int_distribution<Addr> page(0, 4095);
+    std::uniform_int_distribution<int> op(0, 2);
+
+    RadixPageMap<int> map(pageShift);
+    std::unordered_map<Addr, int> ref;
+
+    for (int i = 0; i < 100000; i++) {
+        Addr vaddr = (region(rng) << 40) + (page(rng) << pageShift);
+        int level;
+        bool mapped = map.find(vaddr, level);
+        ASSERT_EQ(mapped, ref.count(vaddr) == 1);
+        if (op(rng) != 0 && !mapped) {
+            map.insert(vaddr, 0, i);
+            ref[vaddr] = i;
+        } else if (mapped) {
+            ASSERT_EQ(*map.find(vaddr, level), ref[vaddr]);
+            map.erase(vaddr, 0);
+            ref.erase(vaddr);
+        }
+        ASSERT_EQ(map.size(), ref.size());
+    }
+
+    std::size_t count = 0;
+    map.forEach([&](Addr vaddr, int level, int val) {
+        EXPECT_EQ(level, 0);
+        EXPECT_EQ(ref.at(vaddr), val);
+        count++;
+    });
+    EXPECT_EQ(count, ref.size());
+}
+
+// Mapping and translating a large footprint with base pages in a hash map
+// against huge pages in the radix map. Disabled by default; run with
+// --gtest_also_run_disabled_tests.
+TEST(RadixPageMapTest, DISABLED_MapTranslateThroughput)
+{
+    constexpr Addr footprint = Addr(4) << 30;
+    constexpr int lookups = 1 << 24;
+
+    std::mt19937_64 rng(0);
+    std::vector<Addr> vaddrs(lookups);
+    for (auto &v : vaddrs)
+        v = rng() % footprint;
+
+    using Clock = std::chrono::steady_clock;
+    auto secs = [](Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    auto start = Clock::now();
+    std::unordered_map<Addr, Addr> old_map;
+    for (Addr v = 0; v < footprint; v += pageBytes)
+        old_map.emplace(v, v);
+    double old_map_secs = secs(start);
+
+    start = Clock::now();
+    Addr sum = 0;
+    for (Addr v : vaddrs)
+        sum += old_map.find(v & ~(pageBytes - 1))->second;
+    double old_lookup_secs = secs(start);
+
+    start = Clock::now();
+    RadixPageMap<Addr> base_map(pageShift);
+    for (Addr v = 0; v < footprint; v += pageBytes)
+        base_map.insert(v, 0, v);
+    double base_map_secs = secs(start);
+
+    start = Clock::now();
+    int level;
+    for (Addr v : vaddrs)
+        sum -= *base_map.find(v, level);
+    double base_lookup_secs = secs(start);
+
+    start = Clock::now();
+    RadixPageMap<Addr> huge_map(pageShift);
+    for (Addr v = 0; v < footprint; v += hugeBytes)
+        huge_map.insert(v, 1, v);
+    double huge_map_secs = secs(start);
+
+    start = Clock::now();
+    for (Addr v : vaddrs)
+        sum += *huge_map.find(v, level);
+    double huge_lookup_secs = secs(start);
+
+    std::cout << "map 4GiB / 16M lookups (s)\n"
+              << "unordered_map, 4KiB pages: " << old_map_secs << " / "
+              << old_lookup_secs << "\n"
+              << "RadixPageMap, 4KiB pages:  " << base_map_secs << " / "
+              << base_lookup_secs << "\n"
+              << "RadixPageMap, 2MiB pages:  " << huge_map_secs << " / "
+              << huge_lookup_secs << "\n";
+    EXPECT_NE(sum, Addr(1));
+}
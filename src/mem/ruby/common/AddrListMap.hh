@@ -0,0 +1,279 @@
+#ifndef __MEM_RUBY_COMMON_ADDRLISTMAP_HH__
+#define __MEM_RUBY_COMMON_ADDRLISTMAP_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+// AddrListMap maps line addresses to FIFO lists of values. It replaces
+// std::map<Addr, std::list<T>> for the message buffers' stall and defer
+// maps, which are updated on every stall and wakeup:
+//  - keys live in an open-addressing table (linear probing with
+//    backward-shift deletion), so lookups touch a single cache line in the
+//    common case and no tree nodes are allocated per address
+//  - list elements are nodes in a pool owned by the map and linked by
+//    index; freed nodes are recycled, so stalling and waking up messages
+//    do not allocate once the pool has grown to its working-set size
+//
+// Values of a key are always returned in insertion order. Iterating over
+// all keys visits them in table order, which is deterministic for a given
+// sequence of operations but not sorted.
+
+template <typename T>
+class AddrListMap
+{
+  public:
+    AddrListMap()
+      : m_slots(minSlots), m_mask(minSlots - 1), m_shift(64 - minSlotsBits),
+        m_size(0), m_numValues(0), m_freeNodes(nil)
+    {}
+
+    // Number of keys with at least one value
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    // Total number of values over all keys
+    std::size_t numValues() const { return m_numValues; }
+
+    bool contains(Addr addr) const { return find(addr) != npos; }
+
+    // Number of values held for addr
+    std::size_t
+    count(Addr addr) const
+    {
+        std::size_t idx = find(addr);
+        return idx == npos ? 0 : m_slots[idx].count;
+    }
+
+    // Appends value to the list of addr
+    void
+    append(Addr addr, T value)
+    {
+        std::size_t idx = find(addr);
+        if (idx == npos) {
+            if ((m_size + 1) * 2 > m_slots.size())
+                rehash(m_slots.size() * 2);
+            idx = insertSlot(addr);
+        }
+
+        int32_t node = allocNode(std::move(value));
+        Slot &slot = m_slots[idx];
+        if (slot.head == nil)
+            slot.head = node;
+        else
+            m_nodes[slot.tail].next = node;
+        slot.tail = node;
+        slot.count++;
+        m_numValues++;
+    }
+
+    // Removes addr and calls f on each of its values in insertion order.
+    // f may add values to the map, including to addr. Returns the number
+    // of values removed.
+    template <typename F>
+    std::size_t
+    drain(Addr addr, F f)
+    {
+        std::size_t idx = find(addr);
+        if (idx == npos)
+            return 0;
+        int32_t node = m_slots[idx].head;
+        std::size_t cnt = m_slots[idx].count;
+        eraseSlot(idx);
+        drainNodes(node, f);
+        return cnt;
+    }
+
+    // Removes all keys, calling f on every value. Values of the same key
+    // are visited in insertion order.
+    template <typename F>
+    void
+    drainAll(F f)
+    {
+        std::vector<int32_t> heads;
+        heads.reserve(m_size);
+        for (auto &slot : m_slots) {
+            if (slot.head != nil)
+                heads.push_back(slot.head);
+            slot = Slot();
+        }
+        m_size = 0;
+        for (int32_t node : heads)
+            drainNodes(node, f);
+    }
+
+    // Calls f on every value. Stops and returns true as soon as f returns
+    // true.
+    template <typename F>
+    bool
+    anyOf(F f) const
+    {
+        for (const auto &slot : m_slots) {
+            for (int32_t n = slot.head; n != nil; n = m_nodes[n].next) {
+                if (f(m_nodes[n].value))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    void
+    clear()
+    {
+        m_slots.assign(minSlots, Slot());
+        m_mask = minSlots - 1;
+        m_shift = 64 - minSlotsBits;
+        m_nodes.clear();
+        m_freeNodes = nil;
+        m_size = 0;
+        m_numValues = 0;
+    }
+
+  private:
+    static constexpr int32_t nil = -1;
+    static constexpr std::size_t npos = ~std::size_t(0);
+    static constexpr unsigned minSlotsBits = 4;
+    static constexpr std::size_t minSlots = 1 << minSlotsBits;
+
+    struct Slot
+    {
+        Addr addr = 0;
+        int32_t head = nil; // nil marks an empty slot
+        int32_t tail = nil;
+        std::size_t count = 0;
+    };
+
+    struct Node
+    {
+        T value;
+        int32_t next;
+    };
+
+    std::size_t
+    home(Addr addr) const
+    {
+        // Fibonacci hashing; line addresses have their low bits cleared,
+        // so take the high bits of the product
+        return (uint64_t(addr) * 0x9E3779B97F4A7C15ULL) >> m_shift;
+    }
+
+    std::size_t
+    find(Addr addr) const
+    {
+        for (std::size_t i = home(addr);; i = (i + 1) & m_mask) {
+            const Slot &slot = m_slots[i];
+            if (slot.head == nil)
+                return npos;
+            if (slot.addr == addr)
+                return i;
+        }
+    }
+
+    // Claims the slot for addr, which must not be in the table
+    std::size_t
+    insertSlot(Addr addr)
+    {
+        std::size_t i = home(addr);
+        while (m_slots[i].head != nil)
+            i = (i + 1) & m_mask;
+        m_slots[i].addr = addr;
+        m_size++;
+        // head is set by the caller
+        return i;
+    }
+
+    void
+    eraseSlot(std::size_t i)
+    {
+        assert(m_size > 0);
+        m_size--;
+        // Shift back entries of the same probe sequence into the hole so
+        // lookups never need tombstones
+        std::size_t j = i;
+        while (true) {
+            j = (j + 1) & m_mask;
+            if (m_slots[j].head == nil)
+                break;
+            std::size_t k = home(m_slots[j].addr);
+            bool movable = (j > i) ? (k <= i || k > j) : (k <= i && k > j);
+            if (movable) {
+                m_slots[i] = m_slots[j];
+                i = j;
+            }
+        }
+        m_slots[i] = Slot();
+    }
+
+    void
+    rehash(std::size_t num_slots)
+    {
+        std::vector<Slot> old(num_slots);
+        old.swap(m_slots);
+        m_mask = num_slots - 1;
+        m_shift--;
+        for (const auto &slot : old) {
+            if (slot.head == nil)
+                continue;
+            std::size_t i = home(slot.addr);
+            while (m_slots[i].head != nil)
+                i = (i + 1) & m_mask;
+            m_slots[i] = slot;
+        }
+    }
+
+    int32_t
+    allocNode(T &&value)
+    {
+        if (m_freeNodes != nil) {
+            int32_t n = m_freeNodes;
+            m_freeNodes = m_nodes[n].next;
+            m_nodes[n].value = std::move(value);
+            m_nodes[n].next = nil;
+            return n;
+        }
+        m_nodes.push_back({std::move(value), nil});
+        return m_nodes.size() - 1;
+    }
+
+    template <typename F>
+    void
+    drainNodes(int32_t node, F &f)
+    {
+        while (node != nil) {
+            // f may append and grow m_nodes, so do not keep references
+            T value = std::move(m_nodes[node].value);
+            m_nodes[node].value = T();
+            int32_t next = m_nodes[node].next;
+            m_nodes[node].next = m_freeNodes;
+            m_freeNodes = node;
+            assert(m_numValues > 0);
+            m_numValues--;
+            f(value);
+            node = next;
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    std::size_t m_mask;
+    unsigned m_shift;
+    std::size_t m_size;
+    std::size_t m_numValues;
+
+    std::vector<Node> m_nodes;
+    int32_t m_freeNodes;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_COMMON_ADDRLISTMAP_HH__
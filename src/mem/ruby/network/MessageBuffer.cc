@@ -40,7 +40,11 @@
 
 #include "mem/ruby/network/MessageBuffer.hh"
 
+#include <algorithm>
 #include <cassert>
+#include <map>
+#include <memory>
+#include <mutex>
 
 #include "base/cprintf.hh"
 #include "base/logging.hh"
@@ -57,8 +61,112 @@ namespace ruby
 
 using stl_helpers::operator<<;
 
+namespace
+{
+
+// Construction order of the buffers, used to order messages delivered from
+// other event queues
+uint64_t nextRemoteId = 0;
+
+} // anonymous namespace
+
+/*
+ * Messages sent to a MessageBuffer from an event queue other than the one of
+ * its consumer. There is one mailbox per destination event queue, holding
+ * the messages sent to any of its buffers indexed by arrival tick. A single
+ * event per arrival tick moves them into their buffers ordered by buffer and
+ * then by send order, so the outcome does not depend on how the sending
+ * threads interleaved.
+ */
+struct MessageBuffer::RemoteMailbox
+{
+    struct Entry
+    {
+        MessageBuffer *buffer;
+        uint64_t seq;
+        MsgPtr msg;
+    };
+
+    explicit RemoteMailbox(EventQueue *_eventq) : eventq(_eventq) {}
+
+    static RemoteMailbox *
+    get(EventQueue *eventq)
+    {
+        static std::mutex mailboxes_mutex;
+        static std::map<EventQueue *, std::unique_ptr<RemoteMailbox>>
+            mailboxes;
+
+        std::lock_guard<std::mutex> lock(mailboxes_mutex);
+        auto &mailbox = mailboxes[eventq];
+        if (!mailbox)
+            mailbox.reset(new RemoteMailbox(eventq));
+        return mailbox.get();
+    }
+
+    // Called from the sender's thread
+    void
+    post(Tick when, MessageBuffer *buffer, uint64_t seq, MsgPtr msg)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &entries = pending[when];
+        if (entries.empty()) {
+            // Scheduling on another queue inserts the event at the end of
+            // the current quantum. Deliver before the consumers wake up.
+            eventq->schedule(new EventFunctionWrapper(
+                    [this, when]{ deliver(when); }, "RubyRemoteDelivery",
+                    true, Event::Default_Pri - 1), when);
+        }
+        entries.push_back({buffer, seq, std::move(msg)});
+    }
+
+    // Called from the consumers' thread
+    void
+    deliver(Tick when)
+    {
+        std::vector<Entry> entries;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = pending.find(when);
+            assert(it != pending.end());
+            entries = std::move(it->second);
+            pending.erase(it);
+        }
+
+        std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b) {
+                if (a.buffer->m_remote_id != b.buffer->m_remote_id)
+                    return a.buffer->m_remote_id < b.buffer->m_remote_id;
+                return a.seq < b.seq;
+            });
+
+        for (auto &e : entries)
+            e.buffer->insertMessage(std::move(e.msg), when);
+    }
+
+    // Called for functional accesses, while the other queues are paused
+    template <typename F>
+    bool
+    anyOf(const MessageBuffer *buffer, F f)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto &[when, entries] : pending) {
+            for (auto &e : entries) {
+                if (e.buffer == buffer && f(e.msg))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    EventQueue *eventq;
+    std::mutex mutex;
+    std::map<Tick, std::vector<Entry>> pending;
+};
+
 MessageBuffer::MessageBuffer(const Params &p)
-    : SimObject(p), m_stall_map_size(0), m_max_size(p.buffer_size),
+    : SimObject(p), m_remote_id(nextRemoteId++), m_remote_seq(0),
+    m_remote_mailbox(nullptr), m_remote_producer(nullptr),
+    m_stall_map_size(0), m_max_size(p.buffer_size),
     m_max_dequeue_rate(p.max_dequeue_rate), m_dequeues_this_cy(0),
     m_time_last_time_size_checked(0),
     m_time_last_time_enqueue(0), m_time_last_time_pop(0),
@@ -218,14 +326,11 @@ void
 MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
                        bool bypassStrictFIFO)
 {
-    // record current time incase we have a pop that also adjusts my size
-    if (m_time_last_time_enqueue < current_time) {
-        m_msgs_this_cycle = 0;  // first msg this cycle
-        m_time_last_time_enqueue = current_time;
-    }
-
-    m_msg_counter++;
-    m_msgs_this_cycle++;
+    // In parallel simulations, the consumer may run on another event queue
+    // (host thread) than the sender
+    assert(m_consumer != NULL);
+    bool remote = inParallelMode &&
+        m_consumer->getObject()->eventQueue() != curEventQueue();
 
     // Calculate the arrival time of the message, that is, the first
     // cycle the message can be dequeued.
@@ -242,6 +347,8 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
         arrival_time = current_time + delta;
     } else {
         // Randomization - ignore delta
+        fatal_if(remote, "%s: randomization is not supported for messages "
+                 "between event queues\n", name());
         if (m_strict_fifo) {
             if (m_last_arrival_time < current_time) {
                 m_last_arrival_time = current_time;
@@ -280,6 +387,63 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
 
     msg_ptr->updateDelayedTicks(current_time);
     msg_ptr->setLastEnqueueTime(arrival_time);
+
+    if (remote)
+        enqueueRemote(message, current_time, arrival_time);
+    else
+        insertMessage(message, current_time);
+}
+
+/*
+ * The sender runs up to a simulation quantum ahead of or behind the
+ * consumer, so the message is handed to the consumer's event queue, which
+ * only picks it up at the end of the current quantum. The latency of the
+ * buffer must thus cover the quantum; in other words, the minimum latency
+ * of the links between the controllers and the network on different event
+ * queues bounds the quantum. The sender also cannot see the occupancy of
+ * the buffer, so flow control has to be done by the consumer.
+ */
+void
+MessageBuffer::enqueueRemote(MsgPtr message, Tick current_time,
+                             Tick arrival_time)
+{
+    fatal_if(m_max_size != 0, "%s: buffers between event queues must have "
+             "unlimited size\n", name());
+    panic_if(arrival_time - current_time < simQuantum,
+             "%s: latency %d between event queues is shorter than the "
+             "simulation quantum %d\n", name(), arrival_time - current_time,
+             simQuantum);
+
+    if (m_remote_mailbox == nullptr) {
+        m_remote_mailbox =
+            RemoteMailbox::get(m_consumer->getObject()->eventQueue());
+        m_remote_producer = curEventQueue();
+    }
+    // Messages of one sender are ordered, keep it deterministic
+    panic_if(m_remote_producer != curEventQueue(), "%s: enqueued from "
+             "more than one remote event queue\n", name());
+
+    DPRINTF(RubyQueue, "Enqueue remote arrival_time: %lld, Message: %s\n",
+            arrival_time, *(message.get()));
+
+    m_remote_mailbox->post(arrival_time, this, m_remote_seq++,
+                           std::move(message));
+}
+
+void
+MessageBuffer::insertMessage(MsgPtr message, Tick current_time)
+{
+    // record current time incase we have a pop that also adjusts my size
+    if (m_time_last_time_enqueue < current_time) {
+        m_msgs_this_cycle = 0;  // first msg this cycle
+        m_time_last_time_enqueue = current_time;
+    }
+
+    m_msg_counter++;
+    m_msgs_this_cycle++;
+
+    Message* msg_ptr = message.get();
+    Tick arrival_time = msg_ptr->getLastEnqueueTime();
     msg_ptr->setMsgCounter(m_msg_counter);
 
     // Insert the message into the priority heap
@@ -384,42 +548,61 @@ MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
     m_consumer->scheduleEventAbsolute(future_time);
 }
 
+// Move a stalled message back to the end of m_prio_heap. insertBatch must
+// be called once all messages of a wakeup have been requeued.
 void
-MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
+MessageBuffer::requeue(MsgPtr &m, Tick schdTick)
 {
-    while (!lt.empty()) {
-        MsgPtr m = lt.front();
-        assert(m->getLastEnqueueTime() <= schdTick);
+    assert(m->getLastEnqueueTime() <= schdTick);
 
-        m_prio_heap.push_back(m);
-        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                  std::greater<MsgPtr>());
+    DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
+        schdTick, *(m.get()));
 
-        m_consumer->scheduleEventAbsolute(schdTick);
+    m_prio_heap.push_back(std::move(m));
+}
 
-        DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
-            schdTick, *(m.get()));
+// Restore the heap property for the messages appended to m_prio_heap
+// starting at index first. The heap order only depends on the enqueue time
+// and counter of each message, so the messages can be inserted in any
+// order; rebuilding the whole heap is cheaper than pushing the messages one
+// by one when the batch is large compared to the heap.
+void
+MessageBuffer::insertBatch(std::size_t first, Tick schdTick)
+{
+    std::size_t num = m_prio_heap.size() - first;
+    if (num == 0)
+        return;
 
-        lt.pop_front();
+    if (num > 1 && num * 4 >= first) {
+        make_heap(m_prio_heap.begin(), m_prio_heap.end(),
+                  std::greater<MsgPtr>());
+    } else {
+        for (std::size_t i = first + 1; i <= m_prio_heap.size(); ++i) {
+            push_heap(m_prio_heap.begin(), m_prio_heap.begin() + i,
+                      std::greater<MsgPtr>());
+        }
     }
+
+    m_consumer->scheduleEventAbsolute(schdTick);
 }
 
 void
 MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
 {
     DPRINTF(RubyQueue, "ReanalyzeMessages %#x\n", addr);
-    assert(m_stall_msg_map.count(addr) > 0);
+    assert(m_stall_msg_map.contains(addr));
 
     //
     // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // prio heap.  The insertBatch call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle
     //
-    m_stall_map_size -= m_stall_msg_map[addr].size();
+    std::size_t first = m_prio_heap.size();
+    m_stall_map_size -= m_stall_msg_map.drain(addr,
+        [this, current_time](MsgPtr &m) { requeue(m, current_time); });
     assert(m_stall_map_size >= 0);
-    reanalyzeList(m_stall_msg_map[addr], current_time);
-    m_stall_msg_map.erase(addr);
+    insertBatch(first, current_time);
 }
 
 void
@@ -429,17 +612,16 @@ MessageBuffer::reanalyzeAllMessages(Tick current_time)
 
     //
     // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // prio heap.  The insertBatch call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle.
     //
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end(); ++map_iter) {
-        m_stall_map_size -= map_iter->second.size();
-        assert(m_stall_map_size >= 0);
-        reanalyzeList(map_iter->second, current_time);
-    }
-    m_stall_msg_map.clear();
+    std::size_t first = m_prio_heap.size();
+    m_stall_map_size -= m_stall_msg_map.numValues();
+    assert(m_stall_map_size == 0);
+    m_stall_msg_map.drainAll(
+        [this, current_time](MsgPtr &m) { requeue(m, current_time); });
+    insertBatch(first, current_time);
 }
 
 void
@@ -459,7 +641,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     // Instead the controller is responsible to call reanalyzeMessages when
     // these addresses change state.
     //
-    (m_stall_msg_map[addr]).push_back(message);
+    m_stall_msg_map.append(addr, message);
     m_stall_map_size++;
     m_stall_count++;
 }
@@ -467,7 +649,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
 bool
 MessageBuffer::hasStalledMsg(Addr addr) const
 {
-    return (m_stall_msg_map.count(addr) != 0);
+    return m_stall_msg_map.contains(addr);
 }
 
 void
@@ -475,29 +657,24 @@ MessageBuffer::deferEnqueueingMessage(Addr addr, MsgPtr message)
 {
     DPRINTF(RubyQueue, "Deferring enqueueing message: %s, Address %#x\n",
             *(message.get()), addr);
-    (m_deferred_msg_map[addr]).push_back(message);
+    m_deferred_msg_map.append(addr, message);
 }
 
 void
 MessageBuffer::enqueueDeferredMessages(Addr addr, Tick curTime, Tick delay)
 {
     assert(!isDeferredMsgMapEmpty(addr));
-    std::vector<MsgPtr>& msg_vec = m_deferred_msg_map[addr];
-    assert(msg_vec.size() > 0);
 
     // enqueue all deferred messages associated with this address
-    for (MsgPtr m : msg_vec) {
+    m_deferred_msg_map.drain(addr, [this, curTime, delay](MsgPtr &m) {
         enqueue(m, curTime, delay);
-    }
-
-    msg_vec.clear();
-    m_deferred_msg_map.erase(addr);
+    });
 }
 
 bool
 MessageBuffer::isDeferredMsgMapEmpty(Addr addr) const
 {
-    return m_deferred_msg_map.count(addr) == 0;
+    return !m_deferred_msg_map.contains(addr);
 }
 
 void
@@ -558,24 +735,26 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
             num_functional_accesses++;
     }
 
+    auto access = [&](const MsgPtr &m) {
+        Message *msg = m.get();
+        if (is_read && !mask && msg->functionalRead(pkt))
+            return true;
+        else if (is_read && mask && msg->functionalRead(pkt, *mask))
+            num_functional_accesses++;
+        else if (!is_read && msg->functionalWrite(pkt))
+            num_functional_accesses++;
+        return false;
+    };
+
     // Check the stall queue and write any messages that may
     // correspond to the address in the packet.
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end();
-         ++map_iter) {
-
-        for (std::list<MsgPtr>::iterator it = (map_iter->second).begin();
-            it != (map_iter->second).end(); ++it) {
-
-            Message *msg = (*it).get();
-            if (is_read && !mask && msg->functionalRead(pkt))
-                return 1;
-            else if (is_read && mask && msg->functionalRead(pkt, *mask))
-                num_functional_accesses++;
-            else if (!is_read && msg->functionalWrite(pkt))
-                num_functional_accesses++;
-        }
-    }
+    if (m_stall_msg_map.anyOf(access))
+        return 1;
+
+    // Messages sent from another event queue that are still on their way
+    // to this buffer
+    if (m_remote_mailbox && m_remote_mailbox->anyOf(this, access))
+        return 1;
 
     return num_functional_accesses;
 }
@@ -59,6 +59,7 @@
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/ruby/common/Address.hh"
+#include "mem/ruby/common/AddrListMap.hh"
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/network/dummy_port.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
@@ -194,7 +195,13 @@ class MessageBuffer : public SimObject
     int routingPriority() const { return m_routing_priority; }
 
   private:
-    void reanalyzeList(std::list<MsgPtr> &, Tick);
+    struct RemoteMailbox;
+
+    void enqueueRemote(MsgPtr message, Tick current_time, Tick arrival_time);
+    void insertMessage(MsgPtr message, Tick current_time);
+
+    void requeue(MsgPtr &m, Tick schdTick);
+    void insertBatch(std::size_t first, Tick schdTick);
 
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
@@ -206,9 +213,13 @@ class MessageBuffer : public SimObject
 
     std::function<void()> m_dequeue_callback;
 
-    // use a std::map for the stalled messages as this container is
-    // sorted and ensures a well-defined iteration order
-    typedef std::map<Addr, std::list<MsgPtr> > StallMsgMapType;
+    // Messages from another event queue, see enqueueRemote
+    const uint64_t m_remote_id;
+    uint64_t m_remote_seq;
+    RemoteMailbox *m_remote_mailbox;
+    EventQueue *m_remote_producer;
+
+    typedef AddrListMap<MsgPtr> StallMsgMapType;
 
     /**
      * A map from line addresses to lists of stalled messages for that line.
@@ -226,11 +237,11 @@ class MessageBuffer : public SimObject
     StallMsgMapType m_stall_msg_map;
 
     /**
-     * A map from line addresses to corresponding vectors of messages that
+     * A map from line addresses to corresponding lists of messages that
      * are deferred for enqueueing. Messages in this map are waiting to be
      * enqueued into the message buffer.
      */
-    typedef std::unordered_map<Addr, std::vector<MsgPtr>> DeferredMsgMapType;
+    typedef AddrListMap<MsgPtr> DeferredMsgMapType;
     DeferredMsgMapType m_deferred_msg_map;
 
     /**
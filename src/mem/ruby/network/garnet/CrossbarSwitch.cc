@@ -46,7 +46,7 @@ namespace garnet
 
 CrossbarSwitch::CrossbarSwitch(Router *router)
   : Consumer(router), m_router(router), m_num_vcs(m_router->get_num_vcs()),
-    m_crossbar_activity(0), switchBuffers(0)
+    m_crossbar_activity(0), m_num_pending_flits(0), switchBuffers(0)
 {
 }
 
@@ -65,6 +65,10 @@ CrossbarSwitch::init()
 void
 CrossbarSwitch::wakeup()
 {
+    // Nothing won the switch, so there is nothing to traverse
+    if (m_num_pending_flits == 0)
+        return;
+
     DPRINTF(RubyNetwork, "CrossbarSwitch at Router %d woke up "
             "at time: %lld\n",
             m_router->get_id(), m_router->curCycle());
@@ -86,6 +90,7 @@ CrossbarSwitch::wakeup()
             // in the next cycle
             m_router->getOutputUnit(outport)->insert_flit(t_flit);
             switch_buffer.getTopFlit();
+            m_num_pending_flits--;
             m_crossbar_activity++;
         }
     }
@@ -63,6 +63,7 @@ class CrossbarSwitch : public Consumer
     update_sw_winner(int inport, flit *t_flit)
     {
         switchBuffers[inport].insert(t_flit);
+        m_num_pending_flits++;
     }
 
     inline double get_crossbar_activity() { return m_crossbar_activity; }
@@ -75,6 +76,8 @@ class CrossbarSwitch : public Consumer
     Router *m_router;
     int m_num_vcs;
     double m_crossbar_activity;
+    // Flits granted by the SwitchAllocator that are yet to traverse
+    int m_num_pending_flits;
     std::vector<flitBuffer> switchBuffers;
 };
 
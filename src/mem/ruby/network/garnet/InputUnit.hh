@@ -32,6 +32,7 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_INPUTUNIT_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_INPUTUNIT_HH__
 
+#include <cassert>
 #include <iostream>
 #include <vector>
 
@@ -66,15 +67,22 @@ class InputUnit : public Consumer
     inline void
     set_vc_idle(int vc, Tick curTime)
     {
+        assert(m_num_active_vcs > 0);
+        m_num_active_vcs--;
         virtualChannels[vc].set_idle(curTime);
     }
 
     inline void
     set_vc_active(int vc, Tick curTime)
     {
+        m_num_active_vcs++;
         virtualChannels[vc].set_active(curTime);
     }
 
+    // True if any VC of this port holds a packet. Lets the allocator skip
+    // idle ports without scanning their VCs.
+    inline bool has_active_vc() const { return m_num_active_vcs > 0; }
+
     inline void
     grant_outport(int vc, int outport)
     {
@@ -162,6 +170,7 @@ class InputUnit : public Consumer
     int m_id;
     PortDirection m_direction;
     int m_vc_per_vnet;
+    int m_num_active_vcs;
     NetworkLink *m_in_link;
     CreditLink *m_credit_link;
     flitBuffer creditQueue;
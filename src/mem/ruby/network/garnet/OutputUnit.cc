@@ -141,8 +141,10 @@ OutputUnit::wakeup()
 
         delete t_credit;
 
+        // Wake up the whole router, not just this unit, as flits blocked
+        // on this credit do not keep the router awake by themselves
         if (m_credit_link->isReady(curTick())) {
-            scheduleEvent(Cycles(1));
+            m_router->schedule_wakeup(Cycles(1));
         }
     }
 }
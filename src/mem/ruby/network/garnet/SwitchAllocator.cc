@@ -113,10 +113,13 @@ SwitchAllocator::arbitrate_inports()
     // Select a VC from each input in a round robin manner
     // Independent arbiter at each input port
     for (int inport = 0; inport < m_num_inports; inport++) {
+        auto input_unit = m_router->getInputUnit(inport);
+        if (!input_unit->has_active_vc())
+            continue;
+
         int invc = m_round_robin_invc[inport];
 
         for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
-            auto input_unit = m_router->getInputUnit(inport);
 
             if (input_unit->need_stage(invc, SA_, curTick())) {
                 // This flit is in SA stage
@@ -288,29 +291,9 @@ SwitchAllocator::send_allowed(int inport, int invc, int outport, int outvc)
     // Check if ordering violated (in ordered vnet)
 
     int vnet = get_vnet(invc);
-    bool has_outvc = (outvc != -1);
-    bool has_credit = false;
-
-    auto output_unit = m_router->getOutputUnit(outport);
-    if (!has_outvc) {
-
-        // needs outvc
-        // this is only true for HEAD and HEAD_TAIL flits.
-
-        if (output_unit->has_free_vc(vnet)) {
-
-            has_outvc = true;
-
-            // each VC has at least one buffer,
-            // so no need for additional credit check
-            has_credit = true;
-        }
-    } else {
-        has_credit = output_unit->has_credit(outvc);
-    }
 
     // cannot send if no outvc or no credit.
-    if (!has_outvc || !has_credit)
+    if (!has_resources(vnet, outport, outvc))
         return false;
 
 
@@ -337,6 +320,25 @@ SwitchAllocator::send_allowed(int inport, int invc, int outport, int outvc)
     return true;
 }
 
+/*
+ * Conditions (1) and (2) of send_allowed. These only change when a credit
+ * is received from the downstream router, which wakes this router up.
+ */
+
+bool
+SwitchAllocator::has_resources(int vnet, int outport, int outvc)
+{
+    auto output_unit = m_router->getOutputUnit(outport);
+    if (outvc == -1) {
+        // needs outvc
+        // this is only true for HEAD and HEAD_TAIL flits.
+        // each VC has at least one buffer,
+        // so no need for additional credit check
+        return output_unit->has_free_vc(vnet);
+    }
+    return output_unit->has_credit(outvc);
+}
+
 // Assign a free VC to the winner of the output port.
 int
 SwitchAllocator::vc_allocate(int outport, int inport, int invc)
@@ -353,6 +355,13 @@ SwitchAllocator::vc_allocate(int outport, int inport, int invc)
 
 // Wakeup the router next cycle to perform SA again
 // if there are flits ready.
+// Flits that are stalled waiting for a free output VC or a credit do not
+// keep the router awake: they can only make progress once a credit
+// arrives, and the credit link wakes the router up when that happens.
+// Idle routers, and routers whose flits are all blocked downstream, are
+// thus not woken up until there is something for them to do. Flits only
+// blocked by ordering wait behind a flit in the same port and vnet, so
+// they are covered by the check on that flit.
 void
 SwitchAllocator::check_for_wakeup()
 {
@@ -363,8 +372,14 @@ SwitchAllocator::check_for_wakeup()
     }
 
     for (int i = 0; i < m_num_inports; i++) {
+        auto input_unit = m_router->getInputUnit(i);
+        if (!input_unit->has_active_vc())
+            continue;
+
         for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
+            if (input_unit->need_stage(j, SA_, nextCycle) &&
+                has_resources(get_vnet(j), input_unit->get_outport(j),
+                              input_unit->get_outvc(j))) {
                 m_router->schedule_wakeup(Cycles(1));
                 return;
             }
@@ -0,0 +1,135 @@
+#include "mem/ruby/structures/CXLDeviceModel.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/intmath.hh"
+#include "mem/ruby/system/RubySystem.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+CXLDeviceModel::CXLDeviceModel(statistics::Group *parent, int sf_entries,
+                               int sf_assoc, int link_bytes_per_cycle)
+    : m_assoc(sf_assoc), m_useCount(0),
+      m_linkBytesPerCycle(link_bytes_per_cycle),
+      m_m2sFreeAt(0), m_s2mFreeAt(0),
+      m_stats(parent)
+{
+    if (sf_entries > 0) {
+        assert(sf_assoc > 0);
+        assert((sf_entries % sf_assoc) == 0);
+        int num_sets = sf_entries / sf_assoc;
+        assert(isPowerOf2(num_sets));
+        m_sets.resize(num_sets);
+        for (auto &set : m_sets)
+            set.reserve(sf_assoc);
+    }
+}
+
+CXLDeviceModel::CXLDeviceModelStats::CXLDeviceModelStats(
+    statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(sfInserts, "Number of lines inserted in the CXL snoop filter"),
+      ADD_STAT(sfHits, "Number of requests to lines already tracked by the "
+               "CXL snoop filter"),
+      ADD_STAT(sfReleases, "Number of lines released by host writebacks"),
+      ADD_STAT(backInvalidations, "Number of back-invalidations (BISnp) "
+               "issued due to snoop filter capacity"),
+      ADD_STAT(linkBytes, "Number of bytes transferred over the CXL link"),
+      ADD_STAT(linkQueueCycles, "Cycles transfers waited for the CXL link")
+{
+}
+
+int
+CXLDeviceModel::setIndex(Addr addr) const
+{
+    Addr line = addr >> RubySystem::getBlockSizeBits();
+    return line & (m_sets.size() - 1);
+}
+
+bool
+CXLDeviceModel::sfIsTracked(Addr addr) const
+{
+    if (!sfEnabled())
+        return false;
+    const auto &set = m_sets[setIndex(addr)];
+    return std::any_of(set.begin(), set.end(),
+                       [addr](const SFEntry &e) { return e.addr == addr; });
+}
+
+bool
+CXLDeviceModel::sfNeedsBackInvalidate(Addr addr) const
+{
+    if (!sfEnabled())
+        return false;
+    return (m_sets[setIndex(addr)].size() == m_assoc) && !sfIsTracked(addr);
+}
+
+Addr
+CXLDeviceModel::sfVictim(Addr addr) const
+{
+    assert(sfNeedsBackInvalidate(addr));
+    const auto &set = m_sets[setIndex(addr)];
+    auto victim = std::min_element(set.begin(), set.end(),
+        [](const SFEntry &a, const SFEntry &b) {
+            return a.lastUse < b.lastUse;
+        });
+    return victim->addr;
+}
+
+void
+CXLDeviceModel::sfTrack(Addr addr)
+{
+    if (!sfEnabled())
+        return;
+    auto &set = m_sets[setIndex(addr)];
+    for (auto &e : set) {
+        if (e.addr == addr) {
+            e.lastUse = ++m_useCount;
+            m_stats.sfHits++;
+            return;
+        }
+    }
+    assert(set.size() < m_assoc);
+    set.push_back({addr, ++m_useCount});
+    m_stats.sfInserts++;
+}
+
+void
+CXLDeviceModel::sfUntrack(Addr addr, bool back_invalidate)
+{
+    if (!sfEnabled())
+        return;
+    auto &set = m_sets[setIndex(addr)];
+    auto it = std::find_if(set.begin(), set.end(),
+                           [addr](const SFEntry &e) { return e.addr == addr; });
+    if (it == set.end())
+        return;
+    // order within a set is irrelevant
+    *it = set.back();
+    set.pop_back();
+    if (back_invalidate)
+        m_stats.backInvalidations++;
+    else
+        m_stats.sfReleases++;
+}
+
+Cycles
+CXLDeviceModel::linkDelay(Cycles now, int bytes, bool to_host)
+{
+    m_stats.linkBytes += bytes;
+    if (m_linkBytesPerCycle <= 0)
+        return Cycles(0);
+    Cycles &free_at = to_host ? m_s2mFreeAt : m_m2sFreeAt;
+    Cycles start = std::max(now, free_at);
+    free_at = start + Cycles(divCeil(bytes, m_linkBytesPerCycle));
+    m_stats.linkQueueCycles += start - now;
+    return free_at - now;
+}
+
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,101 @@
+#ifndef __MEM_RUBY_STRUCTURES_CXLDEVICEMODEL_HH__
+#define __MEM_RUBY_STRUCTURES_CXLDEVICEMODEL_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/ruby/common/Address.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+// CXLDeviceModel keeps the device-side state that a CHI memory controller
+// needs to behave like a CXL Type-3 device with HDM-DB coherence:
+//
+// 1) An inclusive, set-associative snoop filter tracking the lines that
+// the host may hold in its caches. When a new line has to be tracked and
+// its set is full, the device must first back-invalidate (BISnp/BIRsp)
+// a victim, which adds a round trip over the CXL link to the critical
+// path of the request that caused the eviction.
+//
+// 2) A simple occupancy model of the CXL.mem link, so back-to-back
+// transfers are serialized at the configured link width. The link is
+// full-duplex, so M2S (host to device) and S2M (device to host)
+// transfers are tracked separately.
+//
+// Both features are disabled when configured with zero entries/width, so
+// the controller behaves exactly as a plain SNF in that case.
+
+class CXLDeviceModel
+{
+  public:
+    CXLDeviceModel(statistics::Group *parent, int sf_entries, int sf_assoc,
+                   int link_bytes_per_cycle);
+
+    // Returns true if the device snoop filter is modeled
+    bool sfEnabled() const { return !m_sets.empty(); }
+
+    // Returns true if the line is currently tracked as host-cached
+    bool sfIsTracked(Addr addr) const;
+
+    // Returns true if tracking the line requires back-invalidating another
+    // line first, i.e. the line is not tracked and its set is full
+    bool sfNeedsBackInvalidate(Addr addr) const;
+
+    // Returns the LRU line in the set of addr. Requires
+    // sfNeedsBackInvalidate(addr)
+    Addr sfVictim(Addr addr) const;
+
+    // Start tracking a line as host-cached, or refresh its LRU position
+    // if already tracked. Requires a free way if the line is not tracked
+    void sfTrack(Addr addr);
+
+    // Stop tracking a line. back_invalidate distinguishes device-initiated
+    // evictions from lines released by host writebacks
+    void sfUntrack(Addr addr, bool back_invalidate);
+
+    // Reserves one direction of the link for transferring the given number
+    // of bytes starting at cycle now and returns the queueing plus
+    // serialization delay seen by the transfer
+    Cycles linkDelay(Cycles now, int bytes, bool to_host);
+
+  private:
+    struct SFEntry
+    {
+        Addr addr;
+        uint64_t lastUse;
+    };
+
+    int setIndex(Addr addr) const;
+
+    std::vector<std::vector<SFEntry>> m_sets;
+    std::size_t m_assoc;
+    uint64_t m_useCount;
+
+    int m_linkBytesPerCycle;
+    Cycles m_m2sFreeAt;
+    Cycles m_s2mFreeAt;
+
+    struct CXLDeviceModelStats : public statistics::Group
+    {
+        CXLDeviceModelStats(statistics::Group *parent);
+
+        statistics::Scalar sfInserts;
+        statistics::Scalar sfHits;
+        statistics::Scalar sfReleases;
+        statistics::Scalar backInvalidations;
+        statistics::Scalar linkBytes;
+        statistics::Scalar linkQueueCycles;
+    } m_stats;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_STRUCTURES_CXLDEVICEMODEL_HH__
@@ -76,6 +76,53 @@ bool RubySystem::m_warmup_enabled = false;
 unsigned RubySystem::m_systems_to_warmup = 0;
 bool RubySystem::m_cooldown_enabled = false;
 
+namespace
+{
+
+/**
+ * Pause every other event queue thread for the lifetime of the object
+ * so that a functional access sees (and updates) a consistent snapshot
+ * of controllers owned by different queues. The caller gives up its own
+ * queue and then takes every main queue lock in index order; threads
+ * that only ever hold one lock at a time (the ScopedMigration rule)
+ * cannot deadlock against this, and neither can two concurrent
+ * functional accesses since they acquire in the same order.
+ */
+class ScopedPauseQueues
+{
+  public:
+    ScopedPauseQueues()
+        : own(inParallelMode ? curEventQueue() : nullptr)
+    {
+        if (!own)
+            return;
+        own->unlock();
+        for (uint32_t i = 0; i < numMainEventQueues; ++i)
+            mainEventQueue[i]->lock();
+    }
+
+    ~ScopedPauseQueues()
+    {
+        if (!own)
+            return;
+        bool own_is_main = false;
+        for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+            if (mainEventQueue[i] == own)
+                own_is_main = true;
+            else
+                mainEventQueue[i]->unlock();
+        }
+        // The caller's queue is left locked, as it was on entry
+        if (!own_is_main)
+            own->lock();
+    }
+
+  private:
+    EventQueue *const own;
+};
+
+} // anonymous namespace
+
 RubySystem::RubySystem(const Params &p)
     : ClockedObject(p), m_access_backing_store(p.access_backing_store),
       m_cache_recorder(NULL)
@@ -503,6 +550,8 @@ RubySystem::resetStats()
 bool
 RubySystem::functionalRead(PacketPtr pkt)
 {
+    ScopedPauseQueues pause;
+
     Addr address(pkt->getAddr());
     Addr line_address = makeLineAddress(address);
 
@@ -619,6 +668,8 @@ RubySystem::functionalRead(PacketPtr pkt)
 bool
 RubySystem::functionalRead(PacketPtr pkt)
 {
+    ScopedPauseQueues pause;
+
     Addr address(pkt->getAddr());
     Addr line_address = makeLineAddress(address);
 
@@ -720,6 +771,8 @@ RubySystem::functionalRead(PacketPtr pkt)
 bool
 RubySystem::functionalWrite(PacketPtr pkt)
 {
+    ScopedPauseQueues pause;
+
     Addr addr(pkt->getAddr());
     Addr line_addr = makeLineAddress(addr);
     AccessPermission access_perm = AccessPermission_NotPresent;
@@ -162,6 +162,18 @@ class AbstractBoard:
         """
         return self.get_memory().get_mem_ports()
 
+    def get_cxl_mem_ports(self) -> Sequence[Tuple[AddrRange, Port]]:
+        """Get the ports through which the CXL memory media is reached.
+
+        Ruby cache hierarchies use these ports to front the CXL range with
+        CXL-aware memory controllers. Boards without CXL memory return an
+        empty list.
+        """
+        cxl_memory = getattr(self, "cxl_memory", None)
+        if cxl_memory is None:
+            return []
+        return cxl_memory.get_mem_ports()
+
     def get_cache_hierarchy(self) -> Optional["AbstractCacheHierarchy"]:
         """Get the cache hierarchy connected to the board.
 
@@ -26,23 +26,41 @@
 
 
 from typing import (
+    Dict,
     List,
     Sequence,
+    Tuple,
 )
 
 from m5.objects import (
+    AbstractMemory,
     Addr,
     AddrRange,
+    BaseCache,
     BaseXBar,
     Bridge,
     CXLBridge,
+    CXLLinkPower,
     CXLMemBar,
+    CXLMissTracker,
+    CXLQoS,
     CowDiskImage,
     IdeDisk,
     IOXBar,
     Pc,
     Port,
     RawDiskImage,
+    X86ACPIHmat,
+    X86ACPIHmatLocality,
+    X86ACPIHmatProximityDomain,
+    X86ACPIMadt,
+    X86ACPIMadtIntSourceOverride,
+    X86ACPIMadtIOAPIC,
+    X86ACPIMadtLAPIC,
+    X86ACPISlit,
+    X86ACPISrat,
+    X86ACPISratLAPIC,
+    X86ACPISratMemory,
     X86E820Entry,
     X86FsLinux,
     X86IntelMPBus,
@@ -53,6 +71,7 @@ from m5.objects import (
     X86SMBiosBiosInformation,
 )
 from m5.params import Latency
+from m5.util import warn
 from m5.util.convert import toMemorySize
 
 from ...isas import ISA
@@ -69,11 +88,25 @@ class X86Board(AbstractSystemBoard, KernelDiskWorkload):
     """
     A board capable of full system simulation for X86.
 
+    The CXL memory is described to the guest as a CPU-less NUMA node (node
+    1) in the ACPI SRAT, with its distance in the SLIT and its latency and
+    bandwidth in the HMAT, so Linux onlines it as a slower memory tier.
+
     **Limitations**
     * Currently, this board's memory is hardcoded to 3GB.
     * Much of the I/O subsystem is hard coded.
     """
 
+    # Access latency (ns) and bandwidth (MB/s) of the NUMA nodes reported
+    # in the HMAT. The CXL values depend on the device type (ASIC or FPGA)
+    # and can be changed with ``set_cxl_numa_attributes``.
+    _dram_latency_ns = 100
+    _dram_bandwidth_mbps = 19200
+    _cxl_asic_latency_ns = 250
+    _cxl_asic_bandwidth_mbps = 16000
+    _cxl_fpga_latency_ns = 450
+    _cxl_fpga_bandwidth_mbps = 12000
+
     def __init__(
         self,
         clk_freq: str,
@@ -127,6 +160,9 @@ class X86Board(AbstractSystemBoard, KernelDiskWorkload):
         interrupts_address_space_base = 0xA000000000000000
         APIC_range_size = 1 << 12
 
+        # Configure CXL Device
+        cxl_mem_range = self._setup_cxl_device()
+
         # Setup memory system specific settings.
         if self.get_cache_hierarchy().is_ruby():
             self.pc.attachIO(self.get_io_bus(), [self.pc.south_bridge.ide.dma, self.pc.south_bridge.cxlmemory.dma])
@@ -152,31 +188,7 @@ class X86Board(AbstractSystemBoard, KernelDiskWorkload):
                 AddrRange(pci_config_address_space_base, Addr.max),
             ]
 
-            # Configure CXL Device
-            cxl_mem_start = 0x100000000
-            cxl_dram = self.get_cxl_memory()
-            cxl_mem_range = AddrRange(Addr(cxl_mem_start), size=cxl_dram.get_size())
             self.bridge.ranges.append(cxl_mem_range)
-            self.pc.south_bridge.cxlmemory.cxl_mem_range = cxl_mem_range
-            cxl_dram.set_memory_range([cxl_mem_range])
-            cxl_abstract_mems = []
-            for mc in cxl_dram.get_memory_controllers():
-                cxl_abstract_mems.append(mc.dram)
-            self.memories.extend(cxl_abstract_mems)
-            self.cxl_mem_bus = CXLMemBar()
-            self.cxl_mem_bus.cpu_side_ports = self.pc.south_bridge.cxlmemory.mem_req_port
-            for _, port in cxl_dram.get_mem_ports():
-                self.cxl_mem_bus.mem_side_ports = port
-
-            self.pc.south_bridge.cxlmemory.BAR0.size = cxl_dram.get_size_str()
-            if self._is_asic:
-                self.pc.south_bridge.cxlmemory.proto_proc_lat = Latency("15ns")
-                self.pc.south_bridge.cxlmemory.rsp_size = 48
-                self.pc.south_bridge.cxlmemory.req_size = 48
-            else:
-                self.pc.south_bridge.cxlmemory.proto_proc_lat = Latency("60ns")
-                self.pc.south_bridge.cxlmemory.rsp_size = 36
-                self.pc.south_bridge.cxlmemory.req_size = 36
 
             self.apicbridge = Bridge(delay="50ns")
             self.apicbridge.cpu_side_port = self.get_io_bus().mem_side_ports
@@ -196,9 +208,10 @@ class X86Board(AbstractSystemBoard, KernelDiskWorkload):
         # Add in a Bios information structure.
         self.workload.smbios_table.structures = [X86SMBiosBiosInformation()]
 
-        # Set up the Intel MP table
+        # Set up the Intel MP table and the matching ACPI MADT
         base_entries = []
         ext_entries = []
+        madt_records = []
         for i in range(self.get_processor().get_num_cores()):
             bp = X86IntelMPProcessor(
                 local_apic_id=i,
@@ -207,6 +220,8 @@ class X86Board(AbstractSystemBoard, KernelDiskWorkload):
                 bootstrap=(i == 0),
             )
             base_entries.append(bp)
+            lapic = X86ACPIMadtLAPIC(acpi_processor_id=i, apic_id=i, flags=1)
+            madt_records.append(lapic)
         io_apic = X86IntelMPIOAPIC(
             id=self.get_processor().get_num_cores(),
             version=0x11,
@@ -216,6 +231,11 @@ class X86Board(AbstractSystemBoard, KernelDiskWorkload):
 
         self.pc.south_bridge.io_apic.apic_id = io_apic.id
         base_entries.append(io_apic)
+        madt_records.append(
+            X86ACPIMadtIOAPIC(
+                id=io_apic.id, address=io_apic.address, int_base=0
+            )
+        )
         pci_bus = X86IntelMPBus(bus_id=0, bus_type="PCI   ")
         base_entries.append(pci_bus)
         isa_bus = X86IntelMPBus(bus_id=1, bus_type="ISA   ")
@@ -236,6 +256,14 @@ class X86Board(AbstractSystemBoard, KernelDiskWorkload):
         )
 
         base_entries.append(pci_dev4_inta)
+        madt_records.append(
+            X86ACPIMadtIntSourceOverride(
+                bus_source=pci_dev4_inta.source_bus_id,
+                irq_source=pci_dev4_inta.source_bus_irq,
+                sys_int=pci_dev4_inta.dest_io_apic_intin,
+                flags=0,
+            )
+        )
 
         def assignISAInt(irq, apicPin):
             assign_8259_to_apic = X86IntelMPIOIntAssignment(
@@ -259,6 +287,11 @@ class X86Board(AbstractSystemBoard, KernelDiskWorkload):
                 dest_io_apic_intin=apicPin,
             )
             base_entries.append(assign_to_apic)
+            madt_records.append(
+                X86ACPIMadtIntSourceOverride(
+                    bus_source=1, irq_source=irq, sys_int=apicPin, flags=0
+                )
+            )
 
         assignISAInt(0, 2)
         assignISAInt(1, 1)
@@ -269,6 +302,8 @@ class X86Board(AbstractSystemBoard, KernelDiskWorkload):
         self.workload.intel_mp_table.base_entries = base_entries
         self.workload.intel_mp_table.ext_entries = ext_entries
 
+        self._setup_acpi_tables(madt_records, cxl_mem_range)
+
         entries = [
             # Mark the first megabyte of memory as reserved
             X86E820Entry(addr=0, size="639kB", range_type=1),
@@ -290,6 +325,236 @@ class X86Board(AbstractSystemBoard, KernelDiskWorkload):
 
         self.workload.e820_table.entries = entries
 
+    def _setup_acpi_tables(
+        self, madt_records: List, cxl_mem_range: AddrRange
+    ) -> None:
+        """Sets up the ACPI tables: the MADT, and the SRAT, SLIT and HMAT
+        describing host DRAM (node 0, with all the CPUs) and the CXL memory
+        (node 1, without CPUs).
+        """
+        num_cores = self.get_processor().get_num_cores()
+
+        srat_records = [
+            X86ACPISratLAPIC(proximity_domain=0, apic_id=i)
+            for i in range(num_cores)
+        ]
+        srat_records.append(
+            X86ACPISratMemory(proximity_domain=0, range=self.mem_ranges[0])
+        )
+        srat_records.append(
+            X86ACPISratMemory(proximity_domain=1, range=cxl_mem_range)
+        )
+
+        self._acpi_slit = X86ACPISlit(oem_id="gem5")
+        self._acpi_hmat_latency = X86ACPIHmatLocality(
+            data_type="AccessLatency",
+            initiators=[0],
+            targets=[0, 1],
+            # Entries in ns
+            base_unit=1000,
+        )
+        self._acpi_hmat_bandwidth = X86ACPIHmatLocality(
+            data_type="AccessBandwidth",
+            initiators=[0],
+            targets=[0, 1],
+            # Entries in 100MB/s, so they fit 16 bits
+            base_unit=100,
+        )
+        if self._is_asic:
+            self.set_cxl_numa_attributes(
+                self._cxl_asic_latency_ns, self._cxl_asic_bandwidth_mbps
+            )
+        else:
+            self.set_cxl_numa_attributes(
+                self._cxl_fpga_latency_ns, self._cxl_fpga_bandwidth_mbps
+            )
+
+        tables = [
+            X86ACPIMadt(
+                local_apic_address=0, records=madt_records, oem_id="madt"
+            ),
+            X86ACPISrat(records=srat_records, oem_id="gem5"),
+            self._acpi_slit,
+            X86ACPIHmat(
+                records=[
+                    X86ACPIHmatProximityDomain(initiator=0, memory=0),
+                    X86ACPIHmatProximityDomain(memory=1),
+                    self._acpi_hmat_latency,
+                    self._acpi_hmat_bandwidth,
+                ],
+                oem_id="gem5",
+            ),
+        ]
+
+        rsdp = self.workload.acpi_description_table_pointer
+        rsdp.oem_id = "gem5"
+        rsdp.rsdt.oem_id = "gem5"
+        rsdp.xsdt.oem_id = "gem5"
+        rsdp.rsdt.entries = tables
+        rsdp.xsdt.entries = tables
+
+    def set_cxl_numa_attributes(
+        self, latency_ns: int, bandwidth_mbps: int
+    ) -> None:
+        """Sets the access latency and bandwidth of the CXL memory NUMA node
+        reported to the guest in the ACPI HMAT. The SLIT distance is derived
+        from the latency ratio to host DRAM.
+
+        :param latency_ns: The access latency of the CXL memory in ns.
+        :param bandwidth_mbps: The bandwidth of the CXL memory in MB/s.
+        """
+        dram_latency = self._dram_latency_ns
+        dram_bandwidth = self._dram_bandwidth_mbps
+        self._acpi_hmat_latency.entries = [dram_latency, latency_ns]
+        self._acpi_hmat_bandwidth.entries = [
+            max(1, round(dram_bandwidth / 100)),
+            max(1, round(bandwidth_mbps / 100)),
+        ]
+        # 10 is the distance of a node to itself, remote nodes are further
+        # away in proportion to their latency. 255 means unreachable.
+        distance = min(254, max(11, round(10 * latency_ns / dram_latency)))
+        self._acpi_slit.distances = [10, distance, distance, 10]
+
+    def enable_cxl_miss_tracking(self, max_cxl_mlp: int = 0) -> None:
+        """Tracks the misses outstanding in the caches, the CXLBridge, the
+        CXLMemory device and its media, and reports their occupancy and
+        latency per memory tier in the ``cxl_miss_tracker`` statistics.
+
+        :param max_cxl_mlp: The maximum number of CXL misses each requestor
+                            may have outstanding past the CXLBridge. 0 means
+                            no limit. Only applies to classic caches.
+        """
+        self.cxl_miss_tracker = CXLMissTracker(
+            cxl_ranges=[self.pc.south_bridge.cxlmemory.cxl_mem_range],
+            max_cxl_mlp=max_cxl_mlp,
+        )
+        self.pc.south_bridge.cxlmemory.miss_tracker = self.cxl_miss_tracker
+        if not self.get_cache_hierarchy().is_ruby():
+            self.bridge.miss_tracker = self.cxl_miss_tracker
+
+    def enable_cxl_link_power(self, **params) -> None:
+        """Models the energy of the CXL link and of the controller of the
+        CXLMemory device, and the latency of the link leaving its low power
+        states. The energy is reported in the ``cxl_link_power`` statistics,
+        in pJ as for the DRAM.
+
+        :param params: Parameters of the CXLLinkPower model, e.g.,
+                       ``l1_idle="0"`` to keep the link out of L1.
+        """
+        self.cxl_link_power = CXLLinkPower(**params)
+        self.pc.south_bridge.cxlmemory.link_power = self.cxl_link_power
+
+    def enable_cxl_qos(
+        self,
+        priorities: Dict[str, int],
+        num_priorities: int = 2,
+        default_priority: int = 0,
+    ) -> None:
+        """Splits the traffic to CXL memory into classes of different QoS
+        priority. The CXLBridge and the CXLMemory device serve their queues
+        in priority order, and the CXL memory controllers arbitrate with the
+        same priorities when they support QoS.
+
+        :param priorities: The priority of the requestors whose name starts
+                           with each key, e.g.,
+                           ``{"processor.cores0": 1}``. Higher is served
+                           first.
+        :param num_priorities: The number of priorities.
+        :param default_priority: The priority of the other requestors.
+        """
+        self.cxl_qos = CXLQoS(
+            priorities=num_priorities,
+            requestors=list(priorities.keys()),
+            requestor_priorities=list(priorities.values()),
+            default_priority=default_priority,
+        )
+        self.pc.south_bridge.cxlmemory.qos = self.cxl_qos
+        if not self.get_cache_hierarchy().is_ruby():
+            self.bridge.qos = self.cxl_qos
+
+        for ctrl in self.get_cxl_memory().get_memory_controllers():
+            if hasattr(ctrl, "qos_priorities"):
+                ctrl.qos_priorities = num_priorities
+            else:
+                warn(
+                    f"{type(ctrl).__name__} has no QoS support, the CXL "
+                    "traffic classes stop at the CXLMemory device."
+                )
+
+    @overrides(AbstractSystemBoard)
+    def _pre_instantiate(self):
+        super()._pre_instantiate()
+
+        # The caches only exist once the hierarchy has been incorporated
+        tracker = getattr(self, "cxl_miss_tracker", None)
+        if tracker is not None:
+            for obj in self.get_cache_hierarchy().descendants():
+                if isinstance(obj, BaseCache):
+                    obj.miss_tracker = tracker
+
+    def _get_abstract_memories(
+        self, memory: AbstractMemorySystem
+    ) -> List[AbstractMemory]:
+        """The memories behind the controllers of a memory system. A MemCtrl
+        keeps its memory in the DRAM interface, while external models such
+        as DRAMsim3 and DRAMSys are memories themselves.
+        """
+        return [
+            mc if isinstance(mc, AbstractMemory) else mc.dram
+            for mc in memory.get_memory_controllers()
+        ]
+
+    def _setup_cxl_device(self) -> AddrRange:
+        """Sets up the CXL memory expander behind the south bridge.
+
+        The back-end media is reached through ``cxl_mem_bus``, which the
+        CXLMemory device uses for the CXL.mem path. Ruby hierarchies can
+        also attach a coherent (e.g., CHI HDM-DB) memory controller to the
+        same bus through ``get_cxl_mem_ports``.
+
+        :returns: The address range of the CXL memory.
+        """
+        cxl_mem_start = 0x100000000
+        cxl_dram = self.get_cxl_memory()
+        cxl_mem_range = AddrRange(Addr(cxl_mem_start), size=cxl_dram.get_size())
+        self.pc.south_bridge.cxlmemory.cxl_mem_range = cxl_mem_range
+        cxl_dram.set_memory_range([cxl_mem_range])
+        cxl_abstract_mems = self._get_abstract_memories(cxl_dram)
+        for mem in cxl_abstract_mems:
+            # The CXL media is part of the system memories, so KVM maps its
+            # backing store into the VM as RAM and fast-forwarding does not
+            # exit on CXL accesses. Other CPUs reach the same backing store
+            # through the CXLBridge and the CXLMemory device after a switch.
+            # DRAMSys keeps the data in its own storage instead, so KVM
+            # cannot map it and exits on every CXL access.
+            mem.kvm_map = mem.type != "DRAMSys"
+        self.memories.extend(cxl_abstract_mems)
+        self.cxl_mem_bus = CXLMemBar()
+        self.cxl_mem_bus.cpu_side_ports = self.pc.south_bridge.cxlmemory.mem_req_port
+        for _, port in cxl_dram.get_mem_ports():
+            self.cxl_mem_bus.mem_side_ports = port
+
+        self.pc.south_bridge.cxlmemory.BAR0.size = cxl_dram.get_size_str()
+        if self._is_asic:
+            self.pc.south_bridge.cxlmemory.proto_proc_lat = Latency("15ns")
+            self.pc.south_bridge.cxlmemory.rsp_size = 48
+            self.pc.south_bridge.cxlmemory.req_size = 48
+        else:
+            self.pc.south_bridge.cxlmemory.proto_proc_lat = Latency("60ns")
+            self.pc.south_bridge.cxlmemory.rsp_size = 36
+            self.pc.south_bridge.cxlmemory.req_size = 36
+
+        return cxl_mem_range
+
+    @overrides(AbstractSystemBoard)
+    def get_cxl_mem_ports(self) -> Sequence[Tuple[AddrRange, Port]]:
+        return [
+            (
+                self.pc.south_bridge.cxlmemory.cxl_mem_range,
+                self.cxl_mem_bus.cpu_side_ports,
+            )
+        ]
+
     @overrides(AbstractSystemBoard)
     def has_io_bus(self) -> bool:
         return True
@@ -325,10 +590,7 @@ class X86Board(AbstractSystemBoard, KernelDiskWorkload):
             )
         data_range = AddrRange(memory.get_size())
         memory.set_memory_range([data_range])
-        cpu_abstract_mems = []
-        for mc in memory.get_memory_controllers():
-            cpu_abstract_mems.append(mc.dram)
-        self.memories = cpu_abstract_mems
+        self.memories = self._get_abstract_memories(memory)
         # Add the address range for the IO
         self.mem_ranges = [
             data_range,  # All data
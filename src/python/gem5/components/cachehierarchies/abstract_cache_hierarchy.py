@@ -28,6 +28,7 @@ from abc import (
     ABCMeta,
     abstractmethod,
 )
+from typing import Optional
 
 from m5.objects import SubSystem
 
@@ -72,6 +73,18 @@ class AbstractCacheHierarchy(SubSystem):
         """
         raise NotImplementedError
 
+    def get_sim_quantum(self) -> Optional[int]:
+        """
+        Returns the simulation quantum, in ticks, needed when parts of the
+        cache hierarchy run on different event queues (host threads).
+
+        This must not exceed the minimum latency of the messages exchanged
+        between event queues. Called after the global frequency is fixed.
+
+        :returns: The quantum, or ``None`` if the hierarchy does not need one.
+        """
+        return None
+
     def _post_instantiate(self):
         """Called to set up anything needed after ``m5.instantiate``."""
         pass
@@ -100,3 +100,45 @@ class MemoryController(Memory_Controller):
         self.rspIn.in_port = network.out_port
         self.snpIn.in_port = network.out_port
         self.datIn.in_port = network.out_port
+
+
+class CXLMemoryController(MemoryController):
+    """A memory controller fronting CXL-attached memory (CHI SNF).
+
+    Models the CXL.mem link latency and bandwidth between the host and the
+    Type-3 device and, optionally, an HDM-DB device snoop filter whose
+    capacity evictions back-invalidate lines cached by the host.
+    """
+
+    # Lets fabric topologies (e.g., CXLFabric) place it behind a CXL link
+    _is_cxl_device = True
+
+    def __init__(
+        self,
+        network: RubyNetwork,
+        ranges: List[AddrRange],
+        port: Port,
+        link_latency: int = 0,
+        link_bytes_per_cycle: int = 0,
+        sf_entries: int = 0,
+        sf_assoc: int = 16,
+        bisnp_latency: int = 0,
+    ):
+        """
+        :param link_latency: One-way latency, in cycles, of the CXL link and
+                             device controller.
+        :param link_bytes_per_cycle: Bandwidth of each link direction. Zero
+                                     means unlimited.
+        :param sf_entries: Number of entries of the device snoop filter. Zero
+                           disables HDM-DB back-invalidation.
+        :param sf_assoc: Associativity of the device snoop filter.
+        :param bisnp_latency: Round trip latency, in cycles, of a
+                              back-invalidation (BISnp/BIRsp).
+        """
+        super().__init__(network, ranges, port)
+
+        self.cxl_link_latency = link_latency
+        self.cxl_link_bytes_per_cycle = link_bytes_per_cycle
+        self.cxl_sf_entries = sf_entries
+        self.cxl_sf_assoc = sf_assoc
+        self.cxl_bisnp_latency = bisnp_latency
@@ -25,10 +25,15 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 from itertools import chain
-from typing import List
+from typing import (
+    Callable,
+    List,
+    Optional,
+)
 
 from m5.objects import (
     NULL,
+    RubyNetwork,
     RubyPortProxy,
     RubySequencer,
     RubySystem,
@@ -53,7 +58,10 @@ from gem5.utils.requires import requires
 
 from .nodes.directory import SimpleDirectory
 from .nodes.dma_requestor import DMARequestor
-from .nodes.memory_controller import MemoryController
+from .nodes.memory_controller import (
+    CXLMemoryController,
+    MemoryController,
+)
 from .nodes.private_l1_moesi_cache import PrivateL1MOESICache
 
 
@@ -67,24 +75,66 @@ class PrivateL1CacheHierarchy(AbstractRubyCacheHierarchy):
     The network is a simple point-to-point between all of the controllers.
     """
 
-    def __init__(self, size: str, assoc: int) -> None:
+    def __init__(
+        self,
+        size: str,
+        assoc: int,
+        cxl_link_latency: int = 0,
+        cxl_link_bytes_per_cycle: int = 0,
+        cxl_sf_entries: int = 0,
+        cxl_bisnp_latency: int = 0,
+        network_factory: Optional[Callable[[RubySystem], RubyNetwork]] = None,
+        parallel: bool = False,
+    ) -> None:
         """
         :param size: The size of the priavte I/D caches in the hierarchy.
         :param assoc: The associativity of each cache.
+        :param cxl_link_latency: One-way CXL.mem link latency, in cycles, of
+                                 the controllers fronting CXL memory.
+        :param cxl_link_bytes_per_cycle: CXL link bandwidth per direction.
+                                         Zero means unlimited.
+        :param cxl_sf_entries: Size of the HDM-DB device snoop filter. Zero
+                               disables back-invalidation.
+        :param cxl_bisnp_latency: Back-invalidation round trip, in cycles.
+        :param network_factory: Creates the Ruby network for a RubySystem,
+                                e.g. ``lambda rs: CXLFabric(rs)``. Defaults
+                                to a SimplePt2Pt network.
+        :param parallel: Simulate each core, together with its L1 caches, on
+                         its own event queue (host thread). The network,
+                         directory and memory controllers stay on the main
+                         event queue, and the simulation quantum is set to
+                         one cycle, the minimum latency of the messages
+                         between the L1 caches and the network.
+                         Functional accesses (e.g. from SE syscalls) pause
+                         the other threads while they run.
         """
         super().__init__()
 
         self._size = size
         self._assoc = assoc
+        self._cxl_link_latency = cxl_link_latency
+        self._cxl_link_bytes_per_cycle = cxl_link_bytes_per_cycle
+        self._cxl_sf_entries = cxl_sf_entries
+        self._cxl_bisnp_latency = cxl_bisnp_latency
+        self._network_factory = network_factory or SimplePt2Pt
+        self._parallel = parallel
 
     @overrides(AbstractCacheHierarchy)
     def incorporate_cache(self, board: AbstractBoard) -> None:
         requires(coherence_protocol_required=CoherenceProtocol.CHI)
 
+        if self._parallel and board.has_io_bus():
+            raise Exception(
+                "Parallel simulation of the CHI hierarchy is not supported "
+                "with an IO bus, as the interrupt controllers and IO ports "
+                "of the cores would cross event queues."
+            )
+        self._clk_domain = board.get_clock_domain()
+
         self.ruby_system = RubySystem()
 
         # Ruby's global network.
-        self.ruby_system.network = SimplePt2Pt(self.ruby_system)
+        self.ruby_system.network = self._network_factory(self.ruby_system)
 
         # Network configurations
         # virtual networks: 0=request, 1=snoop, 2=response, 3=data
@@ -199,8 +249,21 @@ class PrivateL1CacheHierarchy(AbstractRubyCacheHierarchy):
         cluster.dcache.downstream_destinations = [self.directory]
         cluster.icache.downstream_destinations = [self.directory]
 
+        if self._parallel:
+            # The controllers and sequencers inherit the event queue of the
+            # cluster. Queue 0 is left to the shared components.
+            cluster.eventq_index = core_num + 1
+            core.get_simobject().eventq_index = core_num + 1
+
         return cluster
 
+    @overrides(AbstractCacheHierarchy)
+    def get_sim_quantum(self) -> Optional[int]:
+        if not self._parallel:
+            return None
+        # The controllers and the network all run on the board clock
+        return self._clk_domain.clock[0].getValue()
+
     def _create_memory_controllers(
         self, board: AbstractBoard
     ) -> List[MemoryController]:
@@ -209,6 +272,18 @@ class PrivateL1CacheHierarchy(AbstractRubyCacheHierarchy):
             mc = MemoryController(self.ruby_system.network, rng, port)
             mc.ruby_system = self.ruby_system
             memory_controllers.append(mc)
+        for rng, port in board.get_cxl_mem_ports():
+            mc = CXLMemoryController(
+                self.ruby_system.network,
+                [rng],
+                port,
+                link_latency=self._cxl_link_latency,
+                link_bytes_per_cycle=self._cxl_link_bytes_per_cycle,
+                sf_entries=self._cxl_sf_entries,
+                bisnp_latency=self._cxl_bisnp_latency,
+            )
+            mc.ruby_system = self.ruby_system
+            memory_controllers.append(mc)
         return memory_controllers
 
     def _create_dma_controllers(
@@ -0,0 +1,207 @@
+from typing import List
+
+from m5.objects import (
+    GarnetExtLink,
+    GarnetIntLink,
+    GarnetNetwork,
+    GarnetNetworkInterface,
+    GarnetRouter,
+    NetworkBridge,
+)
+
+
+class CXLFabric(GarnetNetwork):
+    """A Garnet network modeling a switched CXL fabric.
+
+    Each host has a root-port router to which all of its controllers (caches,
+    directories, DMA) attach, and each Type-3 device has an endpoint router
+    for its memory controller(s). Hosts and devices are spread round-robin
+    over ``num_leaf_switches`` edge switches. With ``num_spine_switches`` > 0
+    every leaf connects to every spine (a two-level Clos as built with PBR
+    switches); otherwise the leaves are directly connected to each other.
+
+    The on-chip side runs at ``flit_size`` bytes per flit. CXL links and
+    switches are ``link_width`` bytes wide; when narrower than a flit, the
+    root ports and device endpoints serialize flits through SerDes units.
+    Routing uses Garnet's table-based shortest path, so any combination of
+    hosts, devices and switches is valid.
+    """
+
+    def __init__(
+        self,
+        ruby_system,
+        num_leaf_switches: int = 1,
+        num_spine_switches: int = 0,
+        flit_size: int = 64,
+        link_width: int = 16,
+        link_latency: int = 8,
+        fabric_link_latency: int = 8,
+        switch_latency: int = 20,
+        root_port_latency: int = 1,
+    ):
+        """
+        :param num_leaf_switches: Number of edge switches hosts and devices
+                                  connect to.
+        :param num_spine_switches: Number of switches in the second level.
+                                   Zero builds a single-level fabric.
+        :param flit_size: On-chip flit size in bytes.
+        :param link_width: Bytes transferred per cycle by CXL links and
+                           switches.
+        :param link_latency: Latency, in cycles, of host and device links.
+        :param fabric_link_latency: Latency, in cycles, of switch-to-switch
+                                    links.
+        :param switch_latency: Pipeline latency, in cycles, of a switch.
+        :param root_port_latency: Latency, in cycles, of host root-port and
+                                  device endpoint routers.
+        """
+        super().__init__()
+
+        assert num_leaf_switches > 0
+        assert link_width > 0 and flit_size % link_width == 0
+
+        self.ruby_system = ruby_system
+        self.ni_flit_size = flit_size
+        self._flit_size = flit_size
+        # Table-based routing handles arbitrary fabrics
+        self.routing_algorithm = 0
+
+        self._num_leaf_switches = num_leaf_switches
+        self._num_spine_switches = num_spine_switches
+        self._link_width = link_width
+        self._link_latency = link_latency
+        self._fabric_link_latency = fabric_link_latency
+        self._switch_latency = switch_latency
+        self._root_port_latency = root_port_latency
+
+        self.netifs = []
+
+    def connectControllers(self, controllers):
+        """Connect the controllers of a single host.
+
+        Controllers fronting CXL memory (e.g., ``CXLMemoryController``) each
+        get their own device; all other controllers belong to the host.
+        """
+        host = []
+        devices = []
+        for c in controllers:
+            if getattr(c, "_is_cxl_device", False):
+                devices.append([c])
+            else:
+                host.append(c)
+        self.connectFabric([host], devices)
+
+    def connectFabric(
+        self,
+        hosts: List[List],
+        devices: List[List],
+    ) -> None:
+        """Build the fabric.
+
+        :param hosts: The controllers of each host, one list per host.
+        :param devices: The controllers of each Type-3 device, one list per
+                        device.
+        """
+        routers = []
+        int_links = []
+        ext_links = []
+
+        def new_router(latency: int, width: int) -> GarnetRouter:
+            router = GarnetRouter(
+                router_id=len(routers), latency=latency, width=width
+            )
+            routers.append(router)
+            return router
+
+        def connect(
+            src, dst, latency: int, src_serdes=False, dst_serdes=False
+        ) -> None:
+            # Garnet internal links are uni-directional
+            for a, b, a_serdes, b_serdes in (
+                (src, dst, src_serdes, dst_serdes),
+                (dst, src, dst_serdes, src_serdes),
+            ):
+                link = GarnetIntLink(
+                    link_id=len(int_links),
+                    src_node=a,
+                    dst_node=b,
+                    latency=latency,
+                    width=self._link_width,
+                    weight=1,
+                )
+                # Only root ports/endpoints are wider than the link
+                if a_serdes:
+                    link.src_serdes = True
+                    self._add_src_bridges(link, self._flit_size)
+                if b_serdes:
+                    link.dst_serdes = True
+                    self._add_dst_bridges(link, self._flit_size)
+                int_links.append(link)
+
+        def attach(router, cntrls) -> None:
+            for c in cntrls:
+                ext_links.append(
+                    GarnetExtLink(
+                        link_id=len(ext_links),
+                        ext_node=c,
+                        int_node=router,
+                        latency=1,
+                    )
+                )
+
+        serdes = self._flit_size != self._link_width
+
+        leaves = [
+            new_router(self._switch_latency, self._link_width)
+            for _ in range(self._num_leaf_switches)
+        ]
+        spines = [
+            new_router(self._switch_latency, self._link_width)
+            for _ in range(self._num_spine_switches)
+        ]
+
+        if spines:
+            for leaf in leaves:
+                for spine in spines:
+                    connect(leaf, spine, self._fabric_link_latency)
+        else:
+            for i, leaf in enumerate(leaves):
+                for other in leaves[i + 1 :]:
+                    connect(leaf, other, self._fabric_link_latency)
+
+        for i, cntrls in enumerate(hosts + devices):
+            port = new_router(self._root_port_latency, self._flit_size)
+            attach(port, cntrls)
+            connect(
+                port,
+                leaves[i % len(leaves)],
+                self._link_latency,
+                src_serdes=serdes,
+            )
+
+        self.routers = routers
+        self.int_links = int_links
+        self.ext_links = ext_links
+
+    def setup_buffers(self):
+        """Create the network interfaces of the controllers."""
+        self.netifs = [
+            GarnetNetworkInterface(id=i) for i in range(len(self.ext_links))
+        ]
+
+    @staticmethod
+    def _add_src_bridges(link: GarnetIntLink, width: int) -> None:
+        link.src_net_bridge = NetworkBridge(
+            link=link.network_link, vtype="OBJECT_LINK", width=width
+        )
+        link.src_cred_bridge = NetworkBridge(
+            link=link.credit_link, vtype="LINK_OBJECT", width=width
+        )
+
+    @staticmethod
+    def _add_dst_bridges(link: GarnetIntLink, width: int) -> None:
+        link.dst_net_bridge = NetworkBridge(
+            link=link.network_link, vtype="LINK_OBJECT", width=width
+        )
+        link.dst_cred_bridge = NetworkBridge(
+            link=link.credit_link, vtype="OBJECT_LINK", width=width
+        )
@@ -537,12 +537,23 @@ class Simulator:
             # scheduling of exits for the non-KVM cores will be incorrect. This
             # will be fixed at a later date.
             processor = self._board.processor
+            sim_quantum = None
             if any(core.is_kvm_core() for core in processor.get_cores()) or (
                 isinstance(processor, SwitchableProcessor)
                 and any(core.is_kvm_core() for core in processor._all_cores())
             ):
                 m5.ticks.fixGlobalFrequency()
-                root.sim_quantum = m5.ticks.fromSeconds(0.001)
+                sim_quantum = m5.ticks.fromSeconds(0.001)
+
+            # Cache hierarchies split over several event queues need a
+            # quantum no longer than the latency between the queues.
+            m5.ticks.fixGlobalFrequency()
+            cache_quantum = self._board.get_cache_hierarchy().get_sim_quantum()
+            if cache_quantum is not None:
+                sim_quantum = min(sim_quantum or cache_quantum, cache_quantum)
+
+            if sim_quantum is not None:
+                root.sim_quantum = sim_quantum
 
             # m5.instantiate() takes a parameter specifying the path to the
             # checkpoint directory. If the parameter is None, no checkpoint
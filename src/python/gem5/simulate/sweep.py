@@ -0,0 +1,210 @@
+import csv
+import itertools
+import json
+import os
+import sys
+import traceback
+from typing import (
+    Any,
+    Callable,
+    Dict,
+    Iterable,
+    List,
+    Optional,
+)
+
+import m5
+from m5.util import warn
+
+from .simulator import Simulator
+
+
+class ForkSweep:
+    """
+    Runs a parameter sweep from a single simulator state. Each point of the
+    sweep is measured in a child process forked from the state the
+    simulator is in when ``run()`` is called, typically right after the OS
+    booted, so the boot is only simulated once. The children change the
+    parameters of the point, simulate and report the requested statistics,
+    which are gathered in one table.
+
+    Only parameters that can be changed after instantiation can be swept,
+    e.g., the latencies and queue sizes of the CXLBridge and the CXLMemory
+    device.
+
+    Example
+    -------
+
+    .. code-block::
+
+        m5.disableAllListeners()  # forking requires it, before instantiate
+        simulator = Simulator(board=board, on_exit_event=...)
+        simulator.run()  # boot up to the point the sweep starts from
+
+        def apply(point):
+            cxl_memory = board.pc.south_bridge.cxlmemory
+            cxl_memory.setProtoProcLat(point["proto_proc_lat"])
+
+        sweep = ForkSweep(
+            simulator,
+            points=ForkSweep.grid(proto_proc_lat=["12ns", "24ns"]),
+            apply=apply,
+            stats=["simSeconds", "board.processor.switch0.core.ipc"],
+        )
+        table = sweep.run()
+
+    The table is also written to ``sweep.csv`` in the output directory. The
+    output of each child is in the ``sweep<N>`` directory next to it.
+    """
+
+    def __init__(
+        self,
+        simulator: Simulator,
+        points: Iterable[Dict[str, Any]],
+        apply: Callable[[Dict[str, Any]], None],
+        stats: List[str],
+        measure: Optional[Callable[[Simulator], None]] = None,
+        max_parallel: Optional[int] = None,
+        reset_stats: bool = True,
+    ) -> None:
+        """
+        :param simulator: The simulator, instantiated and in the state to
+                          fork from.
+        :param points: The parameters of each point of the sweep.
+        :param apply: Called in the child with the parameters of its point
+                      before the measurement.
+        :param stats: The names of the statistics to report, as in
+                      ``stats.txt``. Vectors are reported as their total,
+                      unless they have a single element.
+        :param measure: Simulates the measurement in the child. By default
+                        ``simulator.run()`` is called, which returns as the
+                        exit event handlers of the simulator say.
+        :param max_parallel: The number of children simulating at the same
+                             time. By default, the number of host CPUs.
+        :param reset_stats: Whether to reset the statistics in the child
+                            before the measurement.
+        """
+        self._simulator = simulator
+        self._points = list(points)
+        self._apply = apply
+        self._stats = stats
+        self._measure = measure or (lambda simulator: simulator.run())
+        self._max_parallel = max_parallel or os.cpu_count() or 1
+        self._reset_stats = reset_stats
+        self._table = []
+
+    @staticmethod
+    def grid(**values: List[Any]) -> List[Dict[str, Any]]:
+        """
+        Returns the points of the cartesian product of the values of each
+        parameter, e.g., ``grid(a=[1, 2], b=[3])`` returns
+        ``[{"a": 1, "b": 3}, {"a": 2, "b": 3}]``.
+        """
+        names = list(values.keys())
+        return [
+            dict(zip(names, combination))
+            for combination in itertools.product(*values.values())
+        ]
+
+    def run(self) -> List[Dict[str, Any]]:
+        """
+        Measures every point, at most ``max_parallel`` at a time, and returns
+        a row per point with its parameters, the simulated ticks of the
+        measurement and the statistics. The statistics of a point whose child
+        failed are ``None``.
+        """
+        if not m5.listenersDisabled():
+            raise RuntimeError(
+                "Forking requires the listeners to be disabled, call "
+                "m5.disableAllListeners() before the simulator is run."
+            )
+
+        self._table = [None] * len(self._points)
+        running = {}
+        for index, point in enumerate(self._points):
+            while len(running) >= self._max_parallel:
+                self._wait_child(running)
+
+            pid = m5.fork(os.path.join("%(parent)s", f"sweep{index}"))
+            if pid == 0:
+                self._run_child(point)
+            running[pid] = index
+
+        while running:
+            self._wait_child(running)
+
+        self.write_csv(os.path.join(m5.options.outdir, "sweep.csv"))
+        return self._table
+
+    def write_csv(self, path: str) -> None:
+        """
+        Writes the table of the last run to a CSV file.
+        """
+        names = []
+        for row in self._table:
+            names += [name for name in row.keys() if name not in names]
+
+        with open(path, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=names)
+            writer.writeheader()
+            writer.writerows(self._table)
+
+    def _child_outdir(self, index: int) -> str:
+        return os.path.join(m5.options.outdir, f"sweep{index}")
+
+    def _wait_child(self, running: Dict[int, int]) -> None:
+        pid, status = os.wait()
+        if pid not in running:
+            return
+        index = running.pop(pid)
+
+        row = None
+        result = os.path.join(self._child_outdir(index), "sweep.json")
+        if os.WIFEXITED(status) and os.WEXITSTATUS(status) == 0:
+            try:
+                with open(result) as f:
+                    row = json.load(f)
+            except (OSError, ValueError):
+                pass
+
+        if row is None:
+            warn(
+                f"Sweep point {index} failed, see the output in "
+                f"{self._child_outdir(index)}."
+            )
+            row = dict(self._points[index])
+            row["sim_ticks"] = None
+            row.update({name: None for name in self._stats})
+        self._table[index] = row
+
+    def _stat_value(self, name: str) -> Any:
+        info = self._simulator._root.resolveStat(name)
+        if hasattr(info, "size"):
+            # Vectors and formulas
+            result = info.result
+            return result[0] if len(result) == 1 else info.total
+        if hasattr(info, "value"):
+            return info.value
+        raise ValueError(f"Statistic '{name}' is not a scalar or a vector.")
+
+    def _run_child(self, point: Dict[str, Any]) -> None:
+        status = 1
+        try:
+            self._apply(point)
+            if self._reset_stats:
+                m5.stats.reset()
+            start = m5.curTick()
+            self._measure(self._simulator)
+
+            row = dict(point)
+            row["sim_ticks"] = m5.curTick() - start
+            for name in self._stats:
+                row[name] = self._stat_value(name)
+
+            result = os.path.join(m5.options.outdir, "sweep.json")
+            with open(result, "w") as f:
+                json.dump(row, f, default=str)
+            status = 0
+        except Exception:
+            traceback.print_exc()
+        sys.exit(status)
@@ -300,6 +300,22 @@ class MetaSimObject(type):
             else:
                 setattr(cls, key, val)
 
+    # The parameters and ports of the class do not change once it has
+    # been defined, so their order when creating the C++ params of its
+    # instances is only worked out once.
+    def _cc_param_layout(cls):
+        layout = cls.__dict__.get("_cc_layout")
+        if layout is None:
+            layout = (
+                [
+                    (name, isinstance(cls._params[name], VectorParamDesc))
+                    for name in sorted(cls._params.keys())
+                ],
+                sorted(cls._ports.keys()),
+            )
+            type.__setattr__(cls, "_cc_layout", layout)
+        return layout
+
     def _set_keyword(cls, keyword, val, kwtype):
         if not isinstance(val, kwtype):
             raise TypeError(
@@ -739,6 +755,7 @@ class SimObject(metaclass=MetaSimObject):
         self._name = None
         self._ccObject = None  # pointer to C++ object
         self._ccParams = None
+        self._path = None  # cached by m5.instantiate()
         self._instantiated = False  # really "cloned"
         self._init_called = True  # Checked so subclasses don't forget __init__
 
@@ -998,6 +1015,8 @@ class SimObject(metaclass=MetaSimObject):
                 self.add_child(key, val)
 
     def path(self):
+        if self._path is not None:
+            return self._path
         if not self._parent:
             return f"<orphan {self.__class__}>"
         elif isinstance(self._parent, MetaSimObject):
@@ -1008,6 +1027,12 @@ class SimObject(metaclass=MetaSimObject):
             return self._name
         return ppath + "." + self._name
 
+    # Called by m5.instantiate() once the hierarchy is final, in the order
+    # of descendants() so that every path is built from the cached path
+    # of the parent.
+    def cachePath(self):
+        self._path = self.path()
+
     def path_list(self):
         if self._parent:
             return self._parent.path_list() + [self._name]
@@ -1088,7 +1113,8 @@ class SimObject(metaclass=MetaSimObject):
         return self
 
     def unproxyParams(self):
-        for param in self._params.keys():
+        params, port_names = type(self)._cc_param_layout()
+        for param, _ in params:
             value = self._values.get(param)
             if value != None and isproxy(value):
                 try:
@@ -1102,8 +1128,6 @@ class SimObject(metaclass=MetaSimObject):
 
         # Unproxy ports in sorted order so that 'append' operations on
         # vector ports are done in a deterministic fashion.
-        port_names = list(self._ports.keys())
-        port_names.sort()
         for port_name in port_names:
             port = self._port_refs.get(port_name)
             if port != None:
@@ -1188,9 +1212,8 @@ class SimObject(metaclass=MetaSimObject):
         cc_params = cc_params_struct()
         cc_params.name = str(self)
 
-        param_names = list(self._params.keys())
-        param_names.sort()
-        for param in param_names:
+        params, port_names = type(self)._cc_param_layout()
+        for param, is_vector in params:
             value = self._values.get(param)
             if value is None:
                 fatal(
@@ -1200,7 +1223,7 @@ class SimObject(metaclass=MetaSimObject):
                 )
 
             value = value.getValue()
-            if isinstance(self._params[param], VectorParamDesc):
+            if is_vector:
                 assert isinstance(value, list)
                 vec = getattr(cc_params, param)
                 assert not len(vec)
@@ -1215,8 +1238,6 @@ class SimObject(metaclass=MetaSimObject):
             else:
                 setattr(cc_params, param, value)
 
-        port_names = list(self._ports.keys())
-        port_names.sort()
         for port_name in port_names:
             port = self._port_refs.get(port_name, None)
             if port != None:
@@ -1252,12 +1273,20 @@ class SimObject(metaclass=MetaSimObject):
         return self._ccObject
 
     def descendants(self):
-        yield self
-        # The order of the dict is implementation dependent, so sort
-        # it based on the key (name) to ensure the order is the same
-        # on all hosts
-        for name, child in sorted(self._children.items()):
-            yield from child.descendants()
+        # Walk the tree with an explicit stack, nested generators cost
+        # a frame per level for every object in large hierarchies
+        stack = [self]
+        while stack:
+            obj = stack.pop()
+            yield obj
+            # The order of the dict is implementation dependent, so sort
+            # it based on the key (name) to ensure the order is the same
+            # on all hosts
+            for name, child in sorted(obj._children.items(), reverse=True):
+                if isSimObjectVector(child):
+                    stack.extend(v for v in reversed(child) if isSimObject(v))
+                elif isSimObject(child):
+                    stack.append(child)
 
     # Call C++ to create C++ object corresponding to this object
     def createCCObject(self):
@@ -301,6 +301,14 @@ def parse_options():
         help="Sets the output file for debug. Append '.gz' to the name for it"
         " to be compressed automatically [Default: %default]",
     )
+    option(
+        "--debug-binary",
+        action="store_true",
+        default=False,
+        help="Write debug output as a binary trace, which is much faster and "
+        "smaller. Decode it with util/decode_binary_trace.py. Goes to "
+        "trace.bin unless --debug-file is given",
+    )
     option(
         "--debug-activate",
         metavar="EXPR[,EXPR]",
@@ -610,7 +618,11 @@ def main():
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_binary:
+        debug_file = options.debug_file
+        trace.outputBinary("trace.bin" if debug_file == "cout" else debug_file)
+    else:
+        trace.output(options.debug_file)
 
     for activate in options.debug_activate:
         _check_tracing()
@@ -261,15 +261,19 @@ class AllProxy(BaseProxy):
 
 
 def isproxy(obj):
-    from . import params
-
-    if isinstance(obj, (BaseProxy, params.EthernetAddr)):
+    if isinstance(obj, BaseProxy):
         return True
     elif isinstance(obj, (list, tuple)):
         for v in obj:
             if isproxy(v):
                 return True
-    return False
+        return False
+
+    # Importing is not free and this is called for every parameter of
+    # every object on instantiation, so only import for other values
+    from . import params
+
+    return isinstance(obj, params.EthernetAddr)
 
 
 class ProxyFactory:
@@ -103,10 +103,16 @@ def instantiate(ckpt_dir=None):
     for obj in root.descendants():
         obj.unproxyParams()
 
+    # The hierarchy is final from here on, walk it only once and build
+    # every path only once
+    objs = list(root.descendants())
+    for obj in objs:
+        obj.cachePath()
+
     if options.dump_config:
         ini_file = open(os.path.join(options.outdir, options.dump_config), "w")
         # Print ini sections in sorted order for easier diffing
-        for obj in sorted(root.descendants(), key=lambda o: o.path()):
+        for obj in sorted(objs, key=lambda o: o.path()):
             obj.print_ini(ini_file)
         ini_file.close()
 
@@ -131,13 +137,13 @@ def instantiate(ckpt_dir=None):
     stats.initSimStats()
 
     # Create the C++ sim objects and connect ports
-    for obj in root.descendants():
+    for obj in objs:
         obj.createCCObject()
-    for obj in root.descendants():
+    for obj in objs:
         obj.connectPorts()
 
     # Do a second pass to finish initializing the sim objects
-    for obj in root.descendants():
+    for obj in objs:
         obj.init()
 
     # Do a third pass to initialize statistics
@@ -145,11 +151,11 @@ def instantiate(ckpt_dir=None):
     root.regStats()
 
     # Do a fourth pass to initialize probe points
-    for obj in root.descendants():
+    for obj in objs:
         obj.regProbePoints()
 
     # Do a fifth pass to connect probe listeners
-    for obj in root.descendants():
+    for obj in objs:
         obj.regProbeListeners()
 
     # We want to generate the DVFS diagram for the system. This can only be
@@ -165,10 +171,10 @@ def instantiate(ckpt_dir=None):
     if ckpt_dir:
         _drain_manager.preCheckpointRestore()
         ckpt = _m5.core.getCheckpoint(ckpt_dir)
-        for obj in root.descendants():
+        for obj in objs:
             obj.loadState(ckpt)
     else:
-        for obj in root.descendants():
+        for obj in objs:
             obj.initState()
 
     # Check to see if any of the stat events are in the past after resuming from
@@ -31,4 +31,5 @@ from _m5.trace import (
     enable,
     ignore,
     output,
+    outputBinary,
 )
@@ -45,10 +45,12 @@
 #include <map>
 #include <vector>
 
+#include "base/binary_trace.hh"
 #include "base/compiler.hh"
 #include "base/debug.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
 
 namespace py = pybind11;
@@ -67,6 +69,20 @@ output(const char *filename)
     trace::setDebugLogger(new trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+outputBinary(const char *filename)
+{
+    OutputStream *file_stream = simout.find(filename);
+
+    if (!file_stream)
+        file_stream = simout.create(filename, true);
+
+    auto *logger = new trace::BinaryLogger(*file_stream->stream());
+    trace::setDebugLogger(logger);
+    // The buffers of the threads only reach the file when flushed
+    registerExitCallback([logger]() { logger->flush(); });
+}
+
 static void
 activate(const char *expr)
 {
@@ -129,6 +145,7 @@ pybind_init_debug(py::module_ &m_native)
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("outputBinary", &outputBinary)
         .def("activate", &activate)
         .def("ignore", &ignore)
         .def("enable", &trace::enable)
@@ -50,6 +50,11 @@ class Process(SimObject):
                             table in an architecture-specific format",
     )
     kvmInSE = Param.Bool("false", "initialize the process for KvmCPU in SE")
+    hugePages = Param.Bool(
+        False,
+        "back page faults in mapped regions with huge pages (e.g., 2MiB on "
+        "x86) when the whole huge page is in the region and still unmapped",
+    )
     maxStackSize = Param.MemorySize("64MiB", "maximum size of the stack")
 
     uid = Param.Int(100, "user id")
@@ -121,6 +121,23 @@ class KernelWorkload(Workload):
     )
 
 
+class SEPagePlacement(ScopedEnum):
+    """Where SE mode places pages that have no NUMA policy (see mbind(2)
+    and set_mempolicy(2)). Node 0 is the fast tier and node 1 the slow
+    tier, see SEWorkload.slow_mem_ranges.
+    """
+
+    vals = [
+        # Allocate sequentially from the first memory pool
+        "Sequential",
+        # Allocate from node 0 until fast_mem_limit is reached, then from
+        # node 1
+        "FirstTouch",
+        # Interleave pages over the nodes with interleave_weights
+        "Interleave",
+    ]
+
+
 class SEWorkloadMeta(type(Workload)):
     all_se_workload_classes = []
 
@@ -136,6 +153,25 @@ class SEWorkload(Workload, metaclass=SEWorkloadMeta):
     cxx_class = "gem5::SEWorkload"
     abstract = True
 
+    page_placement = Param.SEPagePlacement(
+        "Sequential", "Placement of pages without a NUMA policy"
+    )
+    slow_mem_ranges = VectorParam.AddrRange(
+        [],
+        "Physical memory ranges of the slow tier (e.g., CXL memory), which "
+        "form NUMA node 1. All other memory is on node 0.",
+    )
+    interleave_weights = VectorParam.Unsigned(
+        [1, 1],
+        "Pages placed on node 0 and node 1 in turn when interleaving "
+        "without a NUMA policy or with MPOL_WEIGHTED_INTERLEAVE",
+    )
+    fast_mem_limit = Param.MemorySize(
+        "0B",
+        "Bytes that FirstTouch places on node 0 before spilling to node 1. "
+        "Zero uses all of node 0.",
+    )
+
     @classmethod
     def _is_compatible_with(cls, obj):
         return False
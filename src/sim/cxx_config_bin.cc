@@ -0,0 +1,296 @@
+#include "sim/cxx_config_bin.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "base/inifile.hh"
+#include "base/str.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+const char magic[8] = { 'g', 'e', 'm', '5', 'c', 'f', 'g', 'b' };
+
+/** Reads the fields of a binary config file, failing on truncation */
+class Reader
+{
+  private:
+    const std::vector<char> &data;
+    std::size_t pos = 0;
+
+  public:
+    Reader(const std::vector<char> &_data) : data(_data) {}
+
+    bool
+    read(uint32_t &value)
+    {
+        if (data.size() - pos < sizeof(value))
+            return false;
+        std::memcpy(&value, data.data() + pos, sizeof(value));
+        pos += sizeof(value);
+        return true;
+    }
+
+    bool
+    read(std::string_view &str)
+    {
+        uint32_t len;
+        if (!read(len) || data.size() - pos < len)
+            return false;
+        str = std::string_view(data.data() + pos, len);
+        pos += len;
+        return true;
+    }
+
+    bool
+    skip(std::size_t bytes)
+    {
+        if (data.size() - pos < bytes)
+            return false;
+        pos += bytes;
+        return true;
+    }
+
+    bool done() const { return pos == data.size(); }
+};
+
+void
+write(std::ostream &os, uint32_t value)
+{
+    os.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+} // anonymous namespace
+
+const std::string_view *
+CxxBinaryConfigFile::findEntry(const std::string &object_name,
+    const std::string &key) const
+{
+    auto object = objects.find(object_name);
+    if (object == objects.end())
+        return NULL;
+
+    auto entry = object->second.find(key);
+    if (entry == object->second.end())
+        return NULL;
+
+    return &entry->second;
+}
+
+bool
+CxxBinaryConfigFile::getParam(const std::string &object_name,
+    const std::string &param_name,
+    std::string &value) const
+{
+    const std::string_view *entry = findEntry(object_name, param_name);
+    if (!entry)
+        return false;
+
+    value = *entry;
+    return true;
+}
+
+bool
+CxxBinaryConfigFile::getParamVector(const std::string &object_name,
+    const std::string &param_name,
+    std::vector<std::string> &values) const
+{
+    const std::string_view *entry = findEntry(object_name, param_name);
+    if (!entry)
+        return false;
+
+    tokenize(values, std::string(*entry), ' ', true);
+    return true;
+}
+
+bool
+CxxBinaryConfigFile::getPortPeers(const std::string &object_name,
+    const std::string &port_name,
+    std::vector<std::string> &peers) const
+{
+    return getParamVector(object_name, port_name, peers);
+}
+
+bool
+CxxBinaryConfigFile::objectExists(const std::string &object) const
+{
+    return objects.find(object) != objects.end();
+}
+
+void
+CxxBinaryConfigFile::getAllObjectNames(std::vector<std::string> &list) const
+{
+    list.insert(list.end(), objectNames.begin(), objectNames.end());
+}
+
+void
+CxxBinaryConfigFile::getObjectChildren(const std::string &object_name,
+    std::vector<std::string> &children, bool return_paths) const
+{
+    if (!getParamVector(object_name, "children", children))
+        return;
+
+    if (return_paths && object_name != "root") {
+        for (auto i = children.begin(); i != children.end(); ++i)
+            *i = object_name + "." + *i;
+    }
+}
+
+bool
+CxxBinaryConfigFile::load(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    std::vector<char> contents((std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    if (file.bad())
+        return false;
+
+    if (contents.size() < sizeof(magic) ||
+        std::memcmp(contents.data(), magic, sizeof(magic)) != 0) {
+        return false;
+    }
+
+    Reader reader(contents);
+    reader.skip(sizeof(magic));
+
+    uint32_t file_version;
+    if (!reader.read(file_version) || file_version != version)
+        return false;
+
+    uint32_t num_strings;
+    if (!reader.read(num_strings))
+        return false;
+    std::vector<std::string_view> strings;
+    for (uint32_t i = 0; i < num_strings; i++) {
+        std::string_view str;
+        if (!reader.read(str))
+            return false;
+        strings.push_back(str);
+    }
+
+    auto string_at = [&strings](uint32_t index, std::string_view &str) {
+        if (index >= strings.size())
+            return false;
+        str = strings[index];
+        return true;
+    };
+
+    uint32_t num_objects;
+    if (!reader.read(num_objects))
+        return false;
+
+    std::vector<std::string_view> new_names;
+    std::unordered_map<std::string_view, EntryTable> new_objects;
+    for (uint32_t i = 0; i < num_objects; i++) {
+        uint32_t name_index, num_entries;
+        std::string_view name;
+        if (!reader.read(name_index) || !string_at(name_index, name) ||
+            !reader.read(num_entries)) {
+            return false;
+        }
+
+        EntryTable &entries = new_objects[name];
+        new_names.push_back(name);
+        entries.reserve(num_entries);
+        for (uint32_t j = 0; j < num_entries; j++) {
+            uint32_t key_index, value_index;
+            std::string_view key, value;
+            if (!reader.read(key_index) || !string_at(key_index, key) ||
+                !reader.read(value_index) || !string_at(value_index, value)) {
+                return false;
+            }
+            entries[key] = value;
+        }
+    }
+
+    if (!reader.done())
+        return false;
+
+    // The views point into the vector's buffer, which moving keeps
+    data = std::move(contents);
+    objectNames = std::move(new_names);
+    objects = std::move(new_objects);
+    return true;
+}
+
+bool
+CxxBinaryConfigFile::isBinaryConfig(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    char start[sizeof(magic)];
+    return file.read(start, sizeof(start)) &&
+        std::memcmp(start, magic, sizeof(magic)) == 0;
+}
+
+bool
+CxxBinaryConfigFile::convert(const std::string &ini_filename,
+    const std::string &bin_filename)
+{
+    IniFile ini;
+    if (!ini.load(ini_filename))
+        return false;
+
+    std::vector<std::string> names;
+    ini.getSectionNames(names);
+    std::sort(names.begin(), names.end());
+
+    // Intern the strings, in order of their first use
+    std::vector<const std::string *> strings;
+    std::unordered_map<std::string, uint32_t> indices;
+    auto intern = [&](const std::string &str) {
+        auto [it, inserted] = indices.emplace(str, strings.size());
+        if (inserted)
+            strings.push_back(&it->first);
+        return it->second;
+    };
+
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> objects;
+    for (const auto &name: names) {
+        std::vector<std::pair<std::string, std::string>> entries;
+        ini.visitSection(name,
+            [&entries](const std::string &key, const std::string &value) {
+                entries.emplace_back(key, value);
+            });
+        std::sort(entries.begin(), entries.end());
+
+        auto &object = objects.emplace_back();
+        object.emplace_back(intern(name), entries.size());
+        for (const auto &[key, value]: entries)
+            object.emplace_back(intern(key), intern(value));
+    }
+
+    std::ofstream file(bin_filename, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    file.write(magic, sizeof(magic));
+    write(file, version);
+
+    write(file, strings.size());
+    for (const std::string *str: strings) {
+        write(file, str->size());
+        file.write(str->data(), str->size());
+    }
+
+    // The first pair of an object is its name and number of entries
+    write(file, objects.size());
+    for (const auto &object: objects) {
+        for (const auto &[first, second]: object) {
+            write(file, first);
+            write(file, second);
+        }
+    }
+
+    file.close();
+    return !file.fail();
+}
+
+} // namespace gem5
@@ -0,0 +1,94 @@
+/**
+ * @file
+ *
+ *  Binary config file reading wrapper for use with CxxConfigManager
+ */
+
+#ifndef __SIM_CXX_CONFIG_BIN_HH__
+#define __SIM_CXX_CONFIG_BIN_HH__
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "sim/cxx_config.hh"
+
+namespace gem5
+{
+
+/** CxxConfigManager interface for binary config files.  These hold the
+ *  same objects and values as the config.ini dumped by a Python run of
+ *  gem5, so a fully elaborated system (e.g., a board whose devices are
+ *  set up in Python) can be instantiated again without Python and
+ *  without parsing text.  Make one from a config.ini with convert().
+ *
+ *  Values are in host byte order:
+ *
+ *      header:   "gem5cfgb" u32 version
+ *      strings:  u32 count, then per string: u32 length chars
+ *      objects:  u32 count, then per object:
+ *                    u32 name u32 entries, then per entry: u32 key u32 value
+ *
+ *  Names, keys and values are indices into the strings, which are only
+ *  stored once. */
+class CxxBinaryConfigFile : public CxxConfigFileBase
+{
+  public:
+    static constexpr uint32_t version = 1;
+
+  protected:
+    typedef std::unordered_map<std::string_view, std::string_view>
+        EntryTable;
+
+    /** The contents of the file, every view below points into it */
+    std::vector<char> data;
+
+    /** Objects in the order of the file, which is sorted by path */
+    std::vector<std::string_view> objectNames;
+
+    std::unordered_map<std::string_view, EntryTable> objects;
+
+    /** Find an entry of an object, NULL if there is none */
+    const std::string_view *findEntry(const std::string &object_name,
+        const std::string &key) const;
+
+  public:
+    CxxBinaryConfigFile() { }
+
+    bool getParam(const std::string &object_name,
+        const std::string &param_name,
+        std::string &value) const override;
+
+    bool getParamVector(const std::string &object_name,
+        const std::string &param_name,
+        std::vector<std::string> &values) const override;
+
+    bool getPortPeers(const std::string &object_name,
+        const std::string &port_name,
+        std::vector<std::string> &peers) const override;
+
+    bool objectExists(const std::string &object_name) const override;
+
+    void getAllObjectNames(std::vector<std::string> &list) const override;
+
+    void getObjectChildren(const std::string &object_name,
+        std::vector<std::string> &children,
+        bool return_paths = false) const override;
+
+    bool load(const std::string &filename) override;
+
+    /** Does the file start like a binary config file? */
+    static bool isBinaryConfig(const std::string &filename);
+
+    /** Write the contents of a .ini config file to a binary config
+     *  file.  Returns false if the .ini cannot be read or the binary
+     *  file cannot be written */
+    static bool convert(const std::string &ini_filename,
+        const std::string &bin_filename);
+};
+
+} // namespace gem5
+
+#endif // __SIM_CXX_CONFIG_BIN_HH__
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "sim/cxx_config_bin.hh"
+#include "sim/cxx_config_ini.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const char *config = R"(
+[root]
+type=Root
+children=system
+full_system=true
+sim_quantum=0
+
+[system]
+type=System
+children=cxlmemory membus
+mem_ranges=0:3221225471 4294967296:12884901887
+workload=Null
+empty=
+
+[system.cxlmemory]
+type=CXLMemory
+cmd_line=console=ttyS0  root=/dev/sda1
+pio=system.membus.mem_side_ports[0]
+
+[system.membus]
+type=CoherentXBar
+mem_side_ports=system.cxlmemory.pio
+)";
+
+/** Temporary files removed at the end of a test */
+class CxxBinaryConfigFileTest : public testing::Test
+{
+  protected:
+    std::vector<std::string> files;
+
+    std::string
+    tempFile(const std::string &contents = "")
+    {
+        char name[] = "cxx-config-XXXXXX";
+        int fd = mkstemp(name);
+        EXPECT_NE(fd, -1);
+        close(fd);
+        files.push_back(name);
+        std::ofstream(name, std::ios::binary) << contents;
+        return name;
+    }
+
+    std::string
+    binaryConfig()
+    {
+        std::string ini = tempFile(config);
+        std::string bin = tempFile();
+        EXPECT_TRUE(CxxBinaryConfigFile::convert(ini, bin));
+        return bin;
+    }
+
+    void
+    TearDown() override
+    {
+        for (const auto &file: files)
+            unlink(file.c_str());
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(CxxBinaryConfigFileTest, Params)
+{
+    CxxBinaryConfigFile conf;
+    ASSERT_TRUE(conf.load(binaryConfig()));
+
+    std::string value;
+    EXPECT_TRUE(conf.getParam("system.cxlmemory", "type", value));
+    EXPECT_EQ(value, "CXLMemory");
+    // Values are kept as they were, only vectors are split
+    EXPECT_TRUE(conf.getParam("system.cxlmemory", "cmd_line", value));
+    EXPECT_EQ(value, "console=ttyS0  root=/dev/sda1");
+    EXPECT_TRUE(conf.getParam("system", "empty", value));
+    EXPECT_EQ(value, "");
+    EXPECT_FALSE(conf.getParam("system", "missing", value));
+    EXPECT_FALSE(conf.getParam("missing", "type", value));
+
+    std::vector<std::string> values;
+    EXPECT_TRUE(conf.getParamVector("system", "mem_ranges", values));
+    EXPECT_EQ(values, std::vector<std::string>({
+        "0:3221225471", "4294967296:12884901887" }));
+
+    std::vector<std::string> peers;
+    EXPECT_TRUE(conf.getPortPeers("system.cxlmemory", "pio", peers));
+    EXPECT_EQ(peers, std::vector<std::string>({
+        "system.membus.mem_side_ports[0]" }));
+}
+
+TEST_F(CxxBinaryConfigFileTest, Objects)
+{
+    CxxBinaryConfigFile conf;
+    ASSERT_TRUE(conf.load(binaryConfig()));
+
+    EXPECT_TRUE(conf.objectExists("root"));
+    EXPECT_TRUE(conf.objectExists("system.membus"));
+    EXPECT_FALSE(conf.objectExists("system.cpu"));
+
+    std::vector<std::string> names;
+    conf.getAllObjectNames(names);
+    EXPECT_EQ(names, std::vector<std::string>({
+        "root", "system", "system.cxlmemory", "system.membus" }));
+
+    std::vector<std::string> children;
+    conf.getObjectChildren("root", children, true);
+    EXPECT_EQ(children, std::vector<std::string>({ "system" }));
+    children.clear();
+    conf.getObjectChildren("system", children, true);
+    EXPECT_EQ(children, std::vector<std::string>({
+        "system.cxlmemory", "system.membus" }));
+    children.clear();
+    conf.getObjectChildren("system", children);
+    EXPECT_EQ(children, std::vector<std::string>({ "cxlmemory", "membus" }));
+}
+
+/** The binary file answers like the .ini it was made from */
+TEST_F(CxxBinaryConfigFileTest, MatchesIni)
+{
+    std::string ini_name = tempFile(config);
+    std::string bin_name = tempFile();
+    ASSERT_TRUE(CxxBinaryConfigFile::convert(ini_name, bin_name));
+
+    CxxIniFile ini;
+    CxxBinaryConfigFile bin;
+    ASSERT_TRUE(ini.load(ini_name));
+    ASSERT_TRUE(bin.load(bin_name));
+
+    std::vector<std::string> ini_names, bin_names;
+    ini.getAllObjectNames(ini_names);
+    bin.getAllObjectNames(bin_names);
+    std::sort(ini_names.begin(), ini_names.end());
+    EXPECT_EQ(ini_names, bin_names);
+
+    for (const auto &object: ini_names) {
+        for (const char *key: { "type", "children", "pio", "sim_quantum",
+                "mem_side_ports", "missing" }) {
+            std::string ini_value, bin_value;
+            EXPECT_EQ(ini.getParam(object, key, ini_value),
+                      bin.getParam(object, key, bin_value));
+            EXPECT_EQ(ini_value, bin_value);
+        }
+    }
+}
+
+TEST_F(CxxBinaryConfigFileTest, BadFiles)
+{
+    CxxBinaryConfigFile conf;
+    EXPECT_FALSE(conf.load("does-not-exist"));
+    EXPECT_FALSE(conf.load(tempFile(config)));
+    EXPECT_FALSE(CxxBinaryConfigFile::isBinaryConfig(tempFile(config)));
+    EXPECT_FALSE(CxxBinaryConfigFile::convert("does-not-exist", tempFile()));
+
+    std::string bin = binaryConfig();
+    EXPECT_TRUE(CxxBinaryConfigFile::isBinaryConfig(bin));
+
+    std::ifstream file(bin, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+
+    // Truncated files are rejected
+    for (std::size_t len: { 8ul, 12ul, contents.size() / 2,
+            contents.size() - 1 }) {
+        EXPECT_FALSE(conf.load(tempFile(contents.substr(0, len))));
+    }
+    // So are files of another version
+    std::string other_version = contents;
+    other_version[8]++;
+    EXPECT_FALSE(conf.load(tempFile(other_version)));
+}
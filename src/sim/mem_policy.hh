@@ -0,0 +1,89 @@
+#ifndef __SIM_MEM_POLICY_HH__
+#define __SIM_MEM_POLICY_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+
+namespace gem5
+{
+
+/**
+ * NUMA memory policy of a process or of a virtual memory area in SE mode,
+ * as set by the set_mempolicy(2) and mbind(2) system calls. Modes use the
+ * Linux MPOL_* numbering so they can be copied to and from the target.
+ *
+ * Node 0 holds the pools of the fast tier (host DRAM) and node 1 those of
+ * the slow tier (e.g., CXL memory), see SEWorkload::slow_mem_ranges.
+ */
+struct MemPolicy
+{
+    enum Mode : int
+    {
+        /** Use the policy of the process, or that of the workload. */
+        Default = 0,
+        /** Prefer the first node of the mask, fall back to the others. */
+        Preferred = 1,
+        /** Only allocate from the nodes of the mask. */
+        Bind = 2,
+        /** Interleave pages evenly over the nodes of the mask. */
+        Interleave = 3,
+        /** Allocate from the local node, which is node 0 in SE mode. */
+        Local = 4,
+        /** Prefer the nodes of the mask, fall back to the others. */
+        PreferredMany = 5,
+        /**
+         * Interleave pages over the nodes of the mask, using the weights
+         * in SEWorkload::interleave_weights.
+         */
+        WeightedInterleave = 6,
+        NumModes
+    };
+
+    Mode mode = Default;
+    uint64_t nodes = 0;
+
+    MemPolicy() {}
+    MemPolicy(Mode mode, uint64_t nodes) : mode(mode), nodes(nodes) {}
+
+    bool isDefault() const { return mode == Default; }
+};
+
+/**
+ * Node that backs virtual page vpn when interleaving pages over the nodes
+ * in the mask, so that consecutive pages go round robin over the nodes.
+ * Each node gets weights[node] pages per round, or one if it has no
+ * weight.
+ * @return The node, or -1 if all the nodes have a weight of zero.
+ */
+inline int
+interleaveNode(uint64_t nodes, int num_nodes,
+               const std::vector<unsigned> &weights, uint64_t vpn)
+{
+    auto weight = [&](int n) -> uint64_t {
+        return n < (int)weights.size() ? weights[n] : 1;
+    };
+
+    uint64_t total = 0;
+    for (int n = 0; n < num_nodes; n++) {
+        if (bits(nodes, n))
+            total += weight(n);
+    }
+    if (total == 0)
+        return -1;
+
+    uint64_t pos = vpn % total;
+    for (int n = 0; n < num_nodes; n++) {
+        if (!bits(nodes, n))
+            continue;
+        if (pos < weight(n))
+            return n;
+        pos -= weight(n);
+    }
+    return -1;
+}
+
+} // namespace gem5
+
+#endif // __SIM_MEM_POLICY_HH__
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "sim/mem_policy.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Nodes backing the pages of a region of npages starting at vpn */
+std::vector<int>
+placeRegion(uint64_t nodes, const std::vector<unsigned> &weights,
+            uint64_t vpn, int npages)
+{
+    std::vector<int> placement;
+    for (int i = 0; i < npages; i++)
+        placement.push_back(interleaveNode(nodes, 2, weights, vpn + i));
+    return placement;
+}
+
+} // anonymous namespace
+
+TEST(MemPolicyTest, InterleavesPagesOfOneAllocation)
+{
+    EXPECT_EQ(placeRegion(0b11, {}, 0, 6),
+              std::vector<int>({0, 1, 0, 1, 0, 1}));
+}
+
+TEST(MemPolicyTest, WeightedInterleave)
+{
+    EXPECT_EQ(placeRegion(0b11, {3, 1}, 0, 8),
+              std::vector<int>({0, 0, 0, 1, 0, 0, 0, 1}));
+}
+
+TEST(MemPolicyTest, PlacementDependsOnlyOnThePage)
+{
+    // The same pages get the same nodes whatever the region they are
+    // allocated in
+    auto whole = placeRegion(0b11, {2, 1}, 16, 8);
+    auto tail = placeRegion(0b11, {2, 1}, 19, 5);
+    EXPECT_EQ(std::vector<int>(whole.begin() + 3, whole.end()), tail);
+}
+
+TEST(MemPolicyTest, NodesOutsideTheMaskAreSkipped)
+{
+    EXPECT_EQ(placeRegion(0b10, {3, 1}, 5, 4),
+              std::vector<int>({1, 1, 1, 1}));
+}
+
+TEST(MemPolicyTest, ZeroWeights)
+{
+    EXPECT_EQ(interleaveNode(0b11, 2, {0, 0}, 7), -1);
+    EXPECT_EQ(placeRegion(0b11, {0, 1}, 0, 3),
+              std::vector<int>({1, 1, 1}));
+}
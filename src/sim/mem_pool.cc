@@ -31,16 +31,19 @@
 
 #include "sim/mem_pool.hh"
 
+#include <algorithm>
+
 #include "base/addr_range.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 
 namespace gem5
 {
 
-MemPool::MemPool(Addr page_shift, Addr ptr, Addr limit)
+MemPool::MemPool(Addr page_shift, Addr ptr, Addr limit, int node)
         : pageShift(page_shift), startPageNum(ptr >> page_shift),
         freePageNum(ptr >> page_shift),
-        _totalPages((limit - ptr) >> page_shift)
+        _totalPages((limit - ptr) >> page_shift), _node(node)
 {
     gem5_assert(_totalPages > 0);
 }
@@ -111,9 +114,20 @@ MemPool::totalBytes() const
     return totalPages() << pageShift;
 }
 
+bool
+MemPool::canAllocate(Addr npages, Addr align_pages) const
+{
+    Counter start = roundUp(freePageNum, align_pages);
+    // Like allocate(), keep at least one page free
+    return start + (Counter)npages < startPageNum + _totalPages;
+}
+
 Addr
-MemPool::allocate(Addr npages)
+MemPool::allocate(Addr npages, Addr align_pages)
 {
+    gem5_assert(isPowerOf2(align_pages));
+    freePageNum = roundUp(freePageNum, align_pages);
+
     Addr return_addr = freePageAddr();
     freePageNum += npages;
 
@@ -130,6 +144,7 @@ MemPool::serialize(CheckpointOut &cp) const
     paramOut(cp, "start_page", startPageNum);
     paramOut(cp, "free_page_num", freePageNum);
     paramOut(cp, "total_pages", _totalPages);
+    paramOut(cp, "node", _node);
 }
 
 void
@@ -139,19 +154,91 @@ MemPool::unserialize(CheckpointIn &cp)
     paramIn(cp, "start_page", startPageNum);
     paramIn(cp, "free_page_num", freePageNum);
     paramIn(cp, "total_pages", _totalPages);
+    optParamIn(cp, "node", _node, false);
 }
 
 void
-MemPools::populate(const AddrRangeList &memories)
+MemPools::populate(const AddrRangeList &memories,
+                   const AddrRangeList &slow_ranges)
 {
-    for (const auto &mem : memories)
-        pools.emplace_back(pageShift, mem.start(), mem.end());
+    for (const auto &mem : memories) {
+        // Split the range at the boundaries of the slow tier
+        AddrRangeList parts = mem - slow_ranges;
+        for (const auto &slow : slow_ranges) {
+            if (!slow.intersects(mem))
+                continue;
+            parts.emplace_back(std::max(mem.start(), slow.start()),
+                               std::min(mem.end(), slow.end()));
+        }
+        parts.sort([](const AddrRange &a, const AddrRange &b) {
+            return a.start() < b.start();
+        });
+
+        for (const auto &r : parts) {
+            bool slow = std::any_of(slow_ranges.begin(), slow_ranges.end(),
+                [&r](const AddrRange &s) { return r.isSubset(s); });
+            pools.emplace_back(pageShift, r.start(), r.end(), slow ? 1 : 0);
+        }
+    }
 }
 
 Addr
-MemPools::allocPhysPages(int npages, int pool_id)
+MemPools::allocPhysPages(int npages, int pool_id, Addr align_pages)
+{
+    return pools[pool_id].allocate(npages, align_pages);
+}
+
+Addr
+MemPools::allocNodePages(int node, int npages, Addr align_pages)
+{
+    for (auto &pool : pools) {
+        if (pool.node() == node && pool.canAllocate(npages, align_pages))
+            return pool.allocate(npages, align_pages);
+    }
+    return MaxAddr;
+}
+
+int
+MemPools::numNodes() const
 {
-    return pools[pool_id].allocate(npages);
+    int num = 0;
+    for (const auto &pool : pools)
+        num = std::max(num, pool.node() + 1);
+    return num;
+}
+
+Addr
+MemPools::nodeMemSize(int node) const
+{
+    Addr size = 0;
+    for (const auto &pool : pools) {
+        if (pool.node() == node)
+            size += pool.totalBytes();
+    }
+    return size;
+}
+
+Addr
+MemPools::nodeAllocatedSize(int node) const
+{
+    Addr size = 0;
+    for (const auto &pool : pools) {
+        if (pool.node() == node)
+            size += pool.allocatedBytes();
+    }
+    return size;
+}
+
+int
+MemPools::nodeOf(Addr paddr) const
+{
+    for (const auto &pool : pools) {
+        if (paddr >= pool.startAddr() &&
+            paddr < pool.startAddr() + pool.totalBytes()) {
+            return pool.node();
+        }
+    }
+    return -1;
 }
 
 Addr
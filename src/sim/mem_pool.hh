@@ -56,12 +56,15 @@ class MemPool : public Serializable
     /** The size of the pool, in number of pages. */
     Counter _totalPages = 0;
 
+    /** NUMA node of the pool, see MemPolicy. */
+    int _node = 0;
+
     MemPool() {}
 
     friend class MemPools;
 
   public:
-    MemPool(Addr page_shift, Addr ptr, Addr limit);
+    MemPool(Addr page_shift, Addr ptr, Addr limit, int node=0);
 
     Counter startPage() const;
     Counter freePage() const;
@@ -77,7 +80,16 @@ class MemPool : public Serializable
     Addr freeBytes() const;
     Addr totalBytes() const;
 
-    Addr allocate(Addr npages);
+    int node() const { return _node; }
+
+    /** Whether allocate(npages, align_pages) would succeed. */
+    bool canAllocate(Addr npages, Addr align_pages=1) const;
+
+    /**
+     * Allocate npages contiguous pages, starting at a multiple of
+     * align_pages pages. Pages skipped for alignment are not reused.
+     */
+    Addr allocate(Addr npages, Addr align_pages=1);
 
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
@@ -93,11 +105,37 @@ class MemPools : public Serializable
   public:
     MemPools(Addr page_shift) : pageShift(page_shift) {}
 
-    void populate(const AddrRangeList &memories);
+    /**
+     * Create a pool for each memory range. Parts of the ranges that are
+     * in slow_ranges get pools on NUMA node 1, the rest on node 0.
+     */
+    void populate(const AddrRangeList &memories,
+                  const AddrRangeList &slow_ranges=AddrRangeList());
 
-    /// Allocate npages contiguous unused physical pages.
+    /// Allocate npages contiguous unused physical pages, starting at a
+    /// multiple of align_pages pages.
     /// @return Starting address of first page
-    Addr allocPhysPages(int npages, int pool_id=0);
+    Addr allocPhysPages(int npages, int pool_id=0, Addr align_pages=1);
+
+    /**
+     * Allocate npages contiguous unused physical pages from the first pool
+     * of a NUMA node with enough free pages.
+     * @return Starting address of first page, or MaxAddr if the node does
+     *         not have enough free memory
+     */
+    Addr allocNodePages(int node, int npages, Addr align_pages=1);
+
+    /** Number of NUMA nodes, i.e. one more than the highest pool node. */
+    int numNodes() const;
+
+    /** Amount of physical memory that exists on a node. */
+    Addr nodeMemSize(int node) const;
+
+    /** Amount of physical memory that has been allocated on a node. */
+    Addr nodeAllocatedSize(int node) const;
+
+    /** NUMA node of a physical address, or -1 if not in any pool. */
+    int nodeOf(Addr paddr) const;
 
     /** Amount of physical memory that exists in a pool. */
     Addr memSize(int pool_id=0) const;
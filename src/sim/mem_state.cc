@@ -28,6 +28,7 @@
 
 #include "sim/mem_state.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "arch/generic/mmu.hh"
@@ -67,6 +68,7 @@ MemState::operator=(const MemState &in)
     _stackMin = in._stackMin;
     _nextThreadStackBase = in._nextThreadStackBase;
     _mmapEnd = in._mmapEnd;
+    _memPolicy = in._memPolicy;
     _vmaList = in._vmaList; /* This assignment does a deep copy. */
 
     return *this;
@@ -388,6 +390,66 @@ MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
     } while (length > 0);
 }
 
+bool
+MemState::bindRegion(Addr start_addr, Addr length, const MemPolicy &policy)
+{
+    Addr end_addr = start_addr + length;
+    const AddrRange range(start_addr, end_addr);
+
+    // Like Linux, fail if there are holes in the range
+    Addr mapped = 0;
+    for (auto &vma : _vmaList) {
+        if (vma.intersects(range)) {
+            mapped += std::min(vma.end(), end_addr) -
+                      std::max(vma.start(), start_addr);
+        }
+    }
+    if (mapped != length)
+        return false;
+
+    for (auto vma = _vmaList.begin(); vma != _vmaList.end(); vma++) {
+        if (!vma->intersects(range))
+            continue;
+
+        // The parts outside of the range keep their policy
+        if (vma->start() < start_addr) {
+            auto left = _vmaList.insert(vma, *vma);
+            left->sliceRegionRight(start_addr);
+            vma->sliceRegionLeft(start_addr);
+        }
+        if (vma->end() > end_addr) {
+            auto right = _vmaList.insert(std::next(vma), *vma);
+            right->sliceRegionLeft(end_addr);
+            vma->sliceRegionRight(end_addr);
+        }
+
+        DPRINTF(Vma, "mbind vma start %#x end %#x mode %d nodes %#x\n",
+                vma->start(), vma->end(), policy.mode, policy.nodes);
+        vma->setMemPolicy(policy);
+    }
+    return true;
+}
+
+const MemPolicy &
+MemState::memPolicy(Addr vaddr) const
+{
+    for (const auto &vma : _vmaList) {
+        if (vma.contains(vaddr))
+            return vma.memPolicy().isDefault() ? _memPolicy : vma.memPolicy();
+    }
+    return _memPolicy;
+}
+
+MemPolicy
+MemState::regionMemPolicy(Addr vaddr) const
+{
+    for (const auto &vma : _vmaList) {
+        if (vma.contains(vaddr))
+            return vma.memPolicy();
+    }
+    return MemPolicy();
+}
+
 bool
 MemState::fixupFault(Addr vaddr)
 {
@@ -398,7 +460,24 @@ MemState::fixupFault(Addr vaddr)
     for (const auto &vma : _vmaList) {
         if (vma.contains(vaddr)) {
             Addr vpage_start = roundDown(vaddr, _pageBytes);
-            _ownerProcess->allocateMem(vpage_start, _pageBytes);
+            Addr vpage_bytes = _pageBytes;
+
+            /**
+             * Fault in a whole huge page if it fits in the region and none
+             * of it has been touched yet.
+             */
+            if (_ownerProcess->hugePages) {
+                auto *pt = _ownerProcess->pTable;
+                Addr huge_bytes = pt->hugePageSize();
+                Addr huge_start = roundDown(vaddr, huge_bytes);
+                if (vma.contains(huge_start) &&
+                    vma.contains(huge_start + huge_bytes - 1) &&
+                    pt->isUnmapped(huge_start, huge_bytes)) {
+                    vpage_start = huge_start;
+                    vpage_bytes = huge_bytes;
+                }
+            }
+            _ownerProcess->allocateMem(vpage_start, vpage_bytes);
 
             /**
              * We are assuming that fresh pages are zero-filled, so there is
@@ -415,7 +494,7 @@ MemState::fixupFault(Addr vaddr)
                     auto *tc = _ownerProcess->system->threads[cid];
                     SETranslatingPortProxy
                         virt_mem(tc, SETranslatingPortProxy::Always);
-                    vma.fillMemPages(vpage_start, _pageBytes, virt_mem);
+                    vma.fillMemPages(vpage_start, vpage_bytes, virt_mem);
                 }
             }
             return true;
@@ -40,6 +40,7 @@
 #include "debug/Vma.hh"
 #include "mem/page_table.hh"
 #include "mem/se_translating_port_proxy.hh"
+#include "sim/mem_policy.hh"
 #include "sim/serialize.hh"
 #include "sim/vma.hh"
 
@@ -185,6 +186,32 @@ class MemState : public Serializable
      */
     void allocateMem(Addr vaddr, int64_t size, bool clobber = false);
 
+    /**
+     * Set the NUMA memory policy of the process (set_mempolicy(2)).
+     */
+    void setMemPolicy(const MemPolicy &policy) { _memPolicy = policy; }
+    const MemPolicy &getMemPolicy() const { return _memPolicy; }
+
+    /**
+     * Set the NUMA memory policy of a range of the address space
+     * (mbind(2)). Regions are split at the boundaries of the range.
+     *
+     * @return false if part of the range is not mapped.
+     */
+    bool bindRegion(Addr start_addr, Addr length, const MemPolicy &policy);
+
+    /**
+     * Get the NUMA memory policy that applies to vaddr: the policy of its
+     * region if set, otherwise the one of the process.
+     */
+    const MemPolicy &memPolicy(Addr vaddr) const;
+
+    /**
+     * Get the policy set on the region of vaddr with mbind(2), which is
+     * the default policy if there is none.
+     */
+    MemPolicy regionMemPolicy(Addr vaddr) const;
+
     void
     serialize(CheckpointOut &cp) const override
     {
@@ -195,6 +222,8 @@ class MemState : public Serializable
         paramOut(cp, "stackMin", _stackMin);
         paramOut(cp, "nextThreadStackBase", _nextThreadStackBase);
         paramOut(cp, "mmapEnd", _mmapEnd);
+        paramOut(cp, "memPolicyMode", (int)_memPolicy.mode);
+        paramOut(cp, "memPolicyNodes", _memPolicy.nodes);
 
         ScopedCheckpointSection sec(cp, "vmalist");
         paramOut(cp, "size", _vmaList.size());
@@ -207,6 +236,10 @@ class MemState : public Serializable
             }
             paramOut(cp, "addrRangeStart", vma.start());
             paramOut(cp, "addrRangeEnd", vma.end());
+            if (!vma.memPolicy().isDefault()) {
+                paramOut(cp, "memPolicyMode", (int)vma.memPolicy().mode);
+                paramOut(cp, "memPolicyNodes", vma.memPolicy().nodes);
+            }
         }
     }
 
@@ -220,6 +253,7 @@ class MemState : public Serializable
         paramIn(cp, "stackMin", _stackMin);
         paramIn(cp, "nextThreadStackBase", _nextThreadStackBase);
         paramIn(cp, "mmapEnd", _mmapEnd);
+        _memPolicy = unserializeMemPolicy(cp);
 
         int count;
         ScopedCheckpointSection sec(cp, "vmalist");
@@ -242,6 +276,7 @@ class MemState : public Serializable
             paramIn(cp, "addrRangeEnd", end);
             _vmaList.emplace_back(AddrRange(start, end), _pageBytes, name,
                                   host_fd, offset);
+            _vmaList.back().setMemPolicy(unserializeMemPolicy(cp));
             close(host_fd);
         }
     }
@@ -252,6 +287,20 @@ class MemState : public Serializable
     std::string printVmaList();
 
   private:
+    /**
+     * Read an optional memory policy from a checkpoint section. Older
+     * checkpoints do not have one.
+     */
+    static MemPolicy
+    unserializeMemPolicy(CheckpointIn &cp)
+    {
+        int mode = MemPolicy::Default;
+        uint64_t nodes = 0;
+        optParamIn(cp, "memPolicyMode", mode, false);
+        optParamIn(cp, "memPolicyNodes", nodes, false);
+        return MemPolicy((MemPolicy::Mode)mode, nodes);
+    }
+
     /**
      * @param
      */
@@ -277,6 +326,9 @@ class MemState : public Serializable
     Addr _nextThreadStackBase;
     Addr _mmapEnd;
 
+    /** NUMA memory policy of the process. */
+    MemPolicy _memPolicy;
+
     /**
      * The _vmaList member is a list of virtual memory areas in the target
      * application space that have been allocated by the target. In most
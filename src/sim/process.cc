@@ -116,6 +116,7 @@ Process::Process(const ProcessParams &params, EmulationPageTable *pTable,
       seWorkload(dynamic_cast<SEWorkload *>(system->workload)),
       useArchPT(params.useArchPT),
       kvmInSE(params.kvmInSE),
+      hugePages(params.hugePages),
       useForClone(false),
       pTable(pTable),
       objFile(obj_file),
@@ -135,6 +136,7 @@ Process::Process(const ProcessParams &params, EmulationPageTable *pTable,
                "Number of system calls")
 {
     fatal_if(!seWorkload, "Couldn't find appropriate workload object.");
+    pTable->setHugePages(hugePages);
     fatal_if(_pid >= System::maxPID, "_pid is too large: %d", _pid);
 
     auto ret_pair = system->PIDs.emplace(_pid);
@@ -336,19 +338,40 @@ Process::allocateMem(Addr vaddr, int64_t size, bool clobber)
     }
 
     const int npages = divCeil(size, page_size);
-    const Addr paddr = seWorkload->allocPhysPages(npages);
     const Addr pages_size = npages * page_size;
-    pTable->map(page_addr, paddr, pages_size,
-                clobber ? EmulationPageTable::Clobber :
-                          EmulationPageTable::MappingFlags(0));
+    const MemPolicy policy = memState->memPolicy(page_addr);
+    const auto flags = clobber ? EmulationPageTable::Clobber :
+                                 EmulationPageTable::MappingFlags(0);
+
+    if (seWorkload->interleaves(policy)) {
+        // Consecutive pages go to different nodes
+        for (Addr offset = 0; offset < pages_size; offset += page_size) {
+            const Addr paddr = seWorkload->allocPhysPages(
+                    1, policy, page_addr + offset);
+            pTable->map(page_addr + offset, paddr, page_size, flags);
+        }
+        return;
+    }
+
+    // Align the physical pages of regions that can hold huge pages, so
+    // that the page table maps them as such
+    const Addr huge_size = pTable->hugePageSize();
+    const Addr align_pages =
+        (hugePages && page_addr % huge_size == 0 && pages_size >= huge_size) ?
+        huge_size / page_size : 1;
+    const Addr paddr = seWorkload->allocPhysPages(
+            npages, policy, page_addr, align_pages);
+    pTable->map(page_addr, paddr, pages_size, flags);
 }
 
 void
 Process::replicatePage(Addr vaddr, Addr new_paddr, ThreadContext *old_tc,
                        ThreadContext *new_tc, bool allocate_page)
 {
-    if (allocate_page)
-        new_paddr = seWorkload->allocPhysPages(1);
+    if (allocate_page) {
+        new_paddr = seWorkload->allocPhysPages(
+                1, memState->memPolicy(vaddr), vaddr);
+    }
 
     // Read from old physical page.
     uint8_t buf_p[pTable->pageSize()];
@@ -178,6 +178,8 @@ class Process : public SimObject
     bool useArchPT;
     // running KVM requires special initialization
     bool kvmInSE;
+    // flag for backing page faults with huge pages where possible
+    bool hugePages;
     // flag for using the process as a thread which shares page tables
     bool useForClone;
 
@@ -27,6 +27,9 @@
 
 #include "sim/se_workload.hh"
 
+#include <algorithm>
+
+#include "base/bitfield.hh"
 #include "cpu/thread_context.hh"
 #include "params/SEWorkload.hh"
 #include "sim/process.hh"
@@ -36,9 +39,25 @@ namespace gem5
 {
 
 SEWorkload::SEWorkload(const Params &p, Addr page_shift) :
-    Workload(p), memPools(page_shift)
+    Workload(p), memPools(page_shift), pageShift(page_shift),
+    pagePlacement(p.page_placement),
+    slowMemRanges(p.slow_mem_ranges.begin(), p.slow_mem_ranges.end()),
+    interleaveWeights(p.interleave_weights),
+    fastMemLimit(p.fast_mem_limit),
+    seStats(this)
 {}
 
+SEWorkload::SEWorkloadStats::SEWorkloadStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(nodePages, statistics::units::Count::get(),
+               "Number of physical pages allocated on each NUMA node")
+{
+    nodePages
+        .init(2)
+        .subname(0, "fast")
+        .subname(1, "slow");
+}
+
 void
 SEWorkload::setSystem(System *sys)
 {
@@ -50,7 +69,7 @@ SEWorkload::setSystem(System *sys)
     if (m5op_range.valid())
         memories -= m5op_range;
 
-    memPools.populate(memories);
+    memPools.populate(memories, slowMemRanges);
 }
 
 void
@@ -72,9 +91,122 @@ SEWorkload::syscall(ThreadContext *tc)
 }
 
 Addr
-SEWorkload::allocPhysPages(int npages, int pool_id)
+SEWorkload::allocPhysPages(int npages, int pool_id, Addr align_pages)
 {
-    return memPools.allocPhysPages(npages, pool_id);
+    std::lock_guard<std::mutex> lock(allocMutex);
+    return memPools.allocPhysPages(npages, pool_id, align_pages);
+}
+
+bool
+SEWorkload::interleaves(const MemPolicy &policy) const
+{
+    switch (policy.mode) {
+      case MemPolicy::Interleave:
+      case MemPolicy::WeightedInterleave:
+        return true;
+      case MemPolicy::Default:
+        return pagePlacement == SEPagePlacement::Interleave;
+      default:
+        return false;
+    }
+}
+
+Addr
+SEWorkload::allocPhysPages(int npages, const MemPolicy &policy, Addr vaddr,
+                           Addr align_pages)
+{
+    std::lock_guard<std::mutex> lock(allocMutex);
+    const int num_nodes = memPools.numNodes();
+    const uint64_t all_nodes = mask(num_nodes);
+    const Addr bytes = Addr(npages) << pageShift;
+
+    uint64_t nodes = 0;
+    bool interleave = false;
+    bool weighted = false;
+    bool strict = false;
+    switch (policy.mode) {
+      case MemPolicy::Bind:
+        nodes = policy.nodes;
+        strict = true;
+        break;
+      case MemPolicy::Preferred:
+      case MemPolicy::PreferredMany:
+        nodes = policy.nodes;
+        break;
+      case MemPolicy::WeightedInterleave:
+        weighted = true;
+        [[fallthrough]];
+      case MemPolicy::Interleave:
+        nodes = policy.nodes;
+        interleave = true;
+        break;
+      case MemPolicy::Local:
+        nodes = 1;
+        break;
+      default:
+        switch (pagePlacement) {
+          case SEPagePlacement::FirstTouch:
+            if (fastMemLimit == 0 ||
+                memPools.nodeAllocatedSize(0) + bytes <= fastMemLimit) {
+                nodes = 1;
+            } else {
+                nodes = 2;
+            }
+            break;
+          case SEPagePlacement::Interleave:
+            nodes = all_nodes;
+            interleave = true;
+            weighted = true;
+            break;
+          default:
+          {
+            Addr paddr = memPools.allocPhysPages(npages, 0, align_pages);
+            seStats.nodePages[std::max(0, memPools.nodeOf(paddr))] +=
+                npages;
+            return paddr;
+          }
+        }
+    }
+    nodes &= all_nodes;
+
+    // Pick the node to try first. Interleaving goes by virtual page, so
+    // placement does not depend on the order in which pages are touched.
+    // Callers allocate interleaved regions one page at a time, see
+    // interleaves().
+    int first = nodes ? ctz64(nodes) : 0;
+    if (interleave && nodes) {
+        static const std::vector<unsigned> unweighted;
+        int node = interleaveNode(nodes, num_nodes,
+                                  weighted ? interleaveWeights : unweighted,
+                                  vaddr >> pageShift);
+        if (node >= 0)
+            first = node;
+    }
+
+    // Then the other nodes of the policy and, unless bound to them, all
+    // remaining nodes
+    std::vector<int> order{first};
+    for (int n = 0; n < num_nodes; n++) {
+        if (n != first && bits(nodes, n))
+            order.push_back(n);
+    }
+    if (!strict) {
+        for (int n = 0; n < num_nodes; n++) {
+            if (n != first && !bits(nodes, n))
+                order.push_back(n);
+        }
+    }
+
+    for (int node : order) {
+        Addr paddr = memPools.allocNodePages(node, npages, align_pages);
+        if (paddr != MaxAddr) {
+            seStats.nodePages[std::min(node, 1)] += npages;
+            return paddr;
+        }
+    }
+    fatal("Out of memory for %d pages with NUMA policy %d and nodes %#x, "
+          "please increase size of physical memory.",
+          npages, policy.mode, policy.nodes);
 }
 
 Addr
@@ -28,7 +28,13 @@
 #ifndef __SIM_SE_WORKLOAD_HH__
 #define __SIM_SE_WORKLOAD_HH__
 
+#include <mutex>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "enums/SEPagePlacement.hh"
 #include "params/SEWorkload.hh"
+#include "sim/mem_policy.hh"
 #include "sim/mem_pool.hh"
 #include "sim/workload.hh"
 
@@ -41,6 +47,27 @@ class SEWorkload : public Workload
     /** Memory allocation objects for all physical memories in the system. */
     MemPools memPools;
 
+    const Addr pageShift;
+
+    /** Placement of pages without a NUMA policy. */
+    const SEPagePlacement pagePlacement;
+    const AddrRangeList slowMemRanges;
+    const std::vector<unsigned> interleaveWeights;
+    const Addr fastMemLimit;
+
+    /**
+     * Serializes allocations when cores of different processes run on
+     * separate event queues and issue syscalls concurrently.
+     */
+    std::mutex allocMutex;
+
+    struct SEWorkloadStats : public statistics::Group
+    {
+        SEWorkloadStats(statistics::Group *parent);
+
+        statistics::Vector nodePages;
+    } seStats;
+
   public:
     using Params = SEWorkloadParams;
 
@@ -89,7 +116,31 @@ class SEWorkload : public Workload
     // For now, assume the only type of events are system calls.
     void event(ThreadContext *tc) override { syscall(tc); }
 
-    Addr allocPhysPages(int npages, int pool_id=0);
+    Addr allocPhysPages(int npages, int pool_id=0, Addr align_pages=1);
+
+    /**
+     * Allocate npages contiguous physical pages to back the virtual
+     * address vaddr, placed according to a NUMA memory policy. Policies
+     * other than MPOL_BIND fall back to other nodes when the chosen ones
+     * are full.
+     * @return Starting address of first page
+     */
+    Addr allocPhysPages(int npages, const MemPolicy &policy, Addr vaddr,
+                        Addr align_pages=1);
+
+    /**
+     * Whether pages under a policy are interleaved over several nodes.
+     * Such regions must be allocated one page at a time, since consecutive
+     * pages go to different nodes.
+     */
+    bool interleaves(const MemPolicy &policy) const;
+
+    /** Number of NUMA nodes with memory. */
+    int numMemNodes() const { return memPools.numNodes(); }
+
+    /** NUMA node of a physical address, or -1 if not in any pool. */
+    int memNodeOf(Addr paddr) const { return memPools.nodeOf(paddr); }
+
     Addr memSize(int pool_id=0) const;
     Addr freeMemSize(int pool_id=0) const;
 };
@@ -47,6 +47,7 @@
 #include "sim/byteswap.hh"
 #include "sim/process.hh"
 #include "sim/proxy_ptr.hh"
+#include "sim/se_workload.hh"
 #include "sim/sim_exit.hh"
 #include "sim/syscall_debug_macros.hh"
 #include "sim/syscall_desc.hh"
@@ -1502,4 +1503,183 @@ getcpuFunc(SyscallDesc *desc, ThreadContext *tc,
     return 0;
 }
 
+namespace
+{
+
+// Linux mode flags and MPOL_F_* / MPOL_MF_* bits of the mempolicy calls.
+constexpr int MPOL_MODE_FLAGS = (1 << 15) | (1 << 14) | (1 << 13);
+constexpr uint64_t MPOL_F_NODE = 1 << 0;
+constexpr uint64_t MPOL_F_ADDR = 1 << 1;
+constexpr uint64_t MPOL_F_MEMS_ALLOWED = 1 << 2;
+constexpr unsigned MPOL_MF_MOVE = 1 << 1;
+constexpr unsigned MPOL_MF_MOVE_ALL = 1 << 2;
+
+/**
+ * Read and check the policy passed to set_mempolicy() or mbind(). Only the
+ * first word of the node mask is read, which covers all the memory nodes
+ * of an SE workload.
+ */
+SyscallReturn
+readMemPolicy(ThreadContext *tc, int mode, VPtr<> nmask, uint64_t maxnode,
+              MemPolicy &policy)
+{
+    auto p = tc->getProcessPtr();
+
+    mode &= ~MPOL_MODE_FLAGS;
+    if (mode < 0 || mode >= MemPolicy::NumModes)
+        return -EINVAL;
+
+    // Like Linux, only the first maxnode - 1 bits of the mask are used
+    uint64_t nodes = 0;
+    if (maxnode > 0)
+        maxnode--;
+    if (nmask && maxnode > 0) {
+        if (!SETranslatingPortProxy(tc).tryReadBlob(
+                    nmask, &nodes, sizeof(nodes))) {
+            return -EFAULT;
+        }
+        nodes = gtoh(nodes, tc->getSystemPtr()->getGuestByteOrder());
+        if (maxnode < 64)
+            nodes &= (uint64_t(1) << maxnode) - 1;
+    }
+
+    uint64_t valid = (uint64_t(1) << p->seWorkload->numMemNodes()) - 1;
+    if (nodes & ~valid)
+        return -EINVAL;
+
+    switch (mode) {
+      case MemPolicy::Default:
+      case MemPolicy::Local:
+        if (nodes)
+            return -EINVAL;
+        break;
+      case MemPolicy::Preferred:
+        // An empty mask means local allocation
+        if (!nodes)
+            mode = MemPolicy::Local;
+        break;
+      default:
+        if (!nodes)
+            return -EINVAL;
+        break;
+    }
+
+    policy = MemPolicy((MemPolicy::Mode)mode, nodes);
+    return 0;
+}
+
+} // anonymous namespace
+
+SyscallReturn
+setMempolicyFunc(SyscallDesc *desc, ThreadContext *tc,
+                 int mode, VPtr<> nmask, uint64_t maxnode)
+{
+    MemPolicy policy;
+    SyscallReturn ret = readMemPolicy(tc, mode, nmask, maxnode, policy);
+    if (ret.encodedValue() != 0)
+        return ret;
+
+    tc->getProcessPtr()->memState->setMemPolicy(policy);
+    return 0;
+}
+
+SyscallReturn
+mbindFunc(SyscallDesc *desc, ThreadContext *tc,
+          VPtr<> start, uint64_t len, int mode,
+          VPtr<> nmask, uint64_t maxnode, unsigned flags)
+{
+    auto p = tc->getProcessPtr();
+    Addr page_bytes = p->pTable->pageSize();
+
+    if (start % page_bytes != 0)
+        return -EINVAL;
+
+    MemPolicy policy;
+    SyscallReturn ret = readMemPolicy(tc, mode, nmask, maxnode, policy);
+    if (ret.encodedValue() != 0)
+        return ret;
+
+    if (flags & (MPOL_MF_MOVE | MPOL_MF_MOVE_ALL))
+        warn_once("mbind: pages already in place are not migrated.\n");
+
+    if (len == 0)
+        return 0;
+    len = roundUp(len, page_bytes);
+
+    if (!p->memState->bindRegion(start, len, policy))
+        return -EFAULT;
+    return 0;
+}
+
+SyscallReturn
+getMempolicyFunc(SyscallDesc *desc, ThreadContext *tc,
+                 VPtr<int> mode, VPtr<> nmask, uint64_t maxnode,
+                 VPtr<> addr, uint64_t flags)
+{
+    auto p = tc->getProcessPtr();
+    ByteOrder bo = tc->getSystemPtr()->getGuestByteOrder();
+    int num_nodes = p->seWorkload->numMemNodes();
+
+    // Check everything before writing any of the results
+    if (flags & ~(MPOL_F_NODE | MPOL_F_ADDR | MPOL_F_MEMS_ALLOWED))
+        return -EINVAL;
+    if (nmask && maxnode < (uint64_t)num_nodes)
+        return -EINVAL;
+    if (addr && !(flags & MPOL_F_ADDR))
+        return -EINVAL;
+
+    int ret_mode;
+    uint64_t nodes;
+    if (flags & MPOL_F_MEMS_ALLOWED) {
+        if (flags & (MPOL_F_NODE | MPOL_F_ADDR))
+            return -EINVAL;
+        ret_mode = MemPolicy::Default;
+        nodes = (uint64_t(1) << num_nodes) - 1;
+    } else if (flags & MPOL_F_ADDR) {
+        if (p->memState->isUnmapped(addr, 1))
+            return -EFAULT;
+        // The policy of the region itself, not the one that applies
+        const MemPolicy policy = p->memState->regionMemPolicy(addr);
+        ret_mode = policy.mode;
+        nodes = policy.nodes;
+        if (flags & MPOL_F_NODE) {
+            // Report the node backing the page, faulting it in if needed
+            Addr paddr;
+            if (!p->pTable->translate(addr, paddr)) {
+                if (!p->memState->fixupFault(addr) ||
+                        !p->pTable->translate(addr, paddr)) {
+                    return -EFAULT;
+                }
+            }
+            ret_mode = std::max(p->seWorkload->memNodeOf(paddr), 0);
+        }
+    } else {
+        const MemPolicy &policy = p->memState->getMemPolicy();
+        ret_mode = policy.mode;
+        nodes = policy.nodes;
+        if (flags & MPOL_F_NODE) {
+            // Only valid for interleaving, where Linux returns the next
+            // node; SE mode interleaves by address so report the first one
+            if (policy.mode != MemPolicy::Interleave &&
+                    policy.mode != MemPolicy::WeightedInterleave) {
+                return -EINVAL;
+            }
+            ret_mode = findLsbSet(policy.nodes);
+        }
+    }
+
+    if (mode)
+        *mode = htog(ret_mode, bo);
+
+    if (nmask && maxnode > 0) {
+        nodes = htog(nodes, bo);
+        if (!SETranslatingPortProxy(tc).tryWriteBlob(
+                    nmask, &nodes, sizeof(nodes))) {
+            return -EFAULT;
+        }
+    }
+
+    return 0;
+}
+
 } // namespace gem5
@@ -350,6 +350,21 @@ SyscallReturn getcpuFunc(SyscallDesc *desc, ThreadContext *tc,
                          VPtr<uint32_t> cpu, VPtr<uint32_t> node,
                          VPtr<uint32_t> tcache);
 
+// Target set_mempolicy() handler.
+SyscallReturn setMempolicyFunc(SyscallDesc *desc, ThreadContext *tc,
+                               int mode, VPtr<> nmask, uint64_t maxnode);
+
+// Target mbind() handler.
+SyscallReturn mbindFunc(SyscallDesc *desc, ThreadContext *tc,
+                        VPtr<> start, uint64_t len, int mode,
+                        VPtr<> nmask, uint64_t maxnode, unsigned flags);
+
+// Target get_mempolicy() handler.
+SyscallReturn getMempolicyFunc(SyscallDesc *desc, ThreadContext *tc,
+                               VPtr<int> mode, VPtr<> nmask,
+                               uint64_t maxnode, VPtr<> addr,
+                               uint64_t flags);
+
 // Target getsockname() handler.
 SyscallReturn getsocknameFunc(SyscallDesc *desc, ThreadContext *tc,
                               int tgt_fd, VPtr<> addrPtr, VPtr<> lenPtr);
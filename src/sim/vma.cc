@@ -42,11 +42,11 @@ VMA::fillMemPages(Addr start, Addr size, PortProxy &port) const
     auto offset = start - _addrRange.start();
 
     /**
-     * Try to copy a full page, but don't overrun the size of the file.
+     * Try to copy the full range, but don't overrun the size of the file.
      */
     if (offset < _hostBufLen) {
-        auto size = std::min(_hostBufLen - offset, _pageBytes);
-        port.writeBlob(start, (uint8_t*)_hostBuf + offset, size);
+        auto len = std::min(_hostBufLen - offset, size);
+        port.writeBlob(start, (uint8_t*)_hostBuf + offset, len);
     }
 }
 
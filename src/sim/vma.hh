@@ -36,6 +36,7 @@
 #include "base/types.hh"
 #include "debug/Vma.hh"
 #include "mem/se_translating_port_proxy.hh"
+#include "sim/mem_policy.hh"
 
 namespace gem5
 {
@@ -105,6 +106,14 @@ class VMA
     void sliceRegionLeft(Addr slice_addr);
 
     const std::string& getName() { return _vmaName; }
+
+    /**
+     * NUMA memory policy of the area, set with mbind(2). Slicing and
+     * copying the area keeps the policy.
+     */
+    const MemPolicy &memPolicy() const { return _memPolicy; }
+    void setMemPolicy(const MemPolicy &policy) { _memPolicy = policy; }
+
     off_t getFileMappingOffset() const
     {
         return hasHostBuf() ? _origHostBuf->getOffset() : 0;
@@ -181,6 +190,8 @@ class VMA
      */
     std::string _vmaName;
 
+    MemPolicy _memPolicy;
+
     /**
      * MappedFileBuffer is a wrapper around a region of host memory backed by a
      * file. The constructor attempts to map a file from host memory, and the
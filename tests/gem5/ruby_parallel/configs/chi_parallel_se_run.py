@@ -0,0 +1,95 @@
+"""
+Runs one copy of a binary on each core of an SE board with the CHI
+PrivateL1CacheHierarchy, either with all cores on one event queue or with
+each core and its L1 controllers on its own host thread (``--parallel``).
+Each core gets its own process, so the cores issue syscalls (and the
+functional accesses and page allocations behind them) concurrently.
+"""
+
+import argparse
+
+from m5.objects import Process
+
+from gem5.components.boards.simple_board import SimpleBoard
+from gem5.components.cachehierarchies.chi.private_l1_cache_hierarchy import (
+    PrivateL1CacheHierarchy,
+)
+from gem5.components.memory import SingleChannelDDR3_1600
+from gem5.components.processors.cpu_types import CPUTypes
+from gem5.components.processors.simple_processor import SimpleProcessor
+from gem5.isas import ISA
+from gem5.resources.resource import obtain_resource
+from gem5.simulate.simulator import Simulator
+from gem5.utils.requires import requires
+
+requires(isa_required=ISA.X86)
+
+parser = argparse.ArgumentParser(
+    description="Run a binary on every core, serially or in parallel."
+)
+
+parser.add_argument(
+    "resource", type=str, help="The gem5 resource binary to run."
+)
+
+parser.add_argument(
+    "-n",
+    "--num-cores",
+    type=int,
+    default=2,
+    required=False,
+    help="The number of CPU cores to run.",
+)
+
+parser.add_argument(
+    "--parallel",
+    action="store_true",
+    help="Simulate each core on its own event queue.",
+)
+
+parser.add_argument(
+    "-r",
+    "--resource-directory",
+    type=str,
+    required=False,
+    help="The directory in which resources will be downloaded or exist.",
+)
+
+args = parser.parse_args()
+
+cache_hierarchy = PrivateL1CacheHierarchy(
+    size="16KiB", assoc=4, parallel=args.parallel
+)
+
+processor = SimpleProcessor(
+    cpu_type=CPUTypes.TIMING, isa=ISA.X86, num_cores=args.num_cores
+)
+
+board = SimpleBoard(
+    clk_freq="3GHz",
+    processor=processor,
+    memory=SingleChannelDDR3_1600(),
+    cache_hierarchy=cache_hierarchy,
+)
+
+binary = obtain_resource(
+    args.resource, resource_directory=args.resource_directory
+)
+board.set_se_binary_workload(binary)
+
+# set_se_binary_workload gives every core the same process, of which only
+# the first thread runs. Give the other cores a process of their own.
+for i, core in enumerate(processor.get_cores()[1:], start=1):
+    process = Process(pid=100 + i)
+    process.executable = binary.get_local_path()
+    process.cmd = [binary.get_local_path()]
+    core.set_workload(process)
+
+simulator = Simulator(board=board)
+simulator.run()
+
+print(
+    "Exiting @ tick {} because {}.".format(
+        simulator.get_current_tick(), simulator.get_last_exit_event_cause()
+    )
+)
@@ -0,0 +1,41 @@
+"""
+Runs two cores on the CHI PrivateL1CacheHierarchy serially and with each
+core on its own event queue. Both runs must produce the same program
+output, which is checked against a single reference.
+"""
+from testlib import *
+
+if config.bin_path:
+    resource_path = config.bin_path
+else:
+    resource_path = joinpath(absdirpath(__file__), "..", "..", "resources")
+
+verifiers = (
+    verifier.MatchStdoutNoPerf(joinpath(getcwd(), "ref", "simout.txt")),
+)
+
+for mode, extra_args in (("serial", []), ("parallel", ["--parallel"])):
+    gem5_verify_config(
+        name=f"test-chi-x86-hello-2-core-{mode}",
+        verifiers=verifiers,
+        fixtures=(),
+        config=joinpath(
+            config.base_dir,
+            "tests",
+            "gem5",
+            "ruby_parallel",
+            "configs",
+            "chi_parallel_se_run.py",
+        ),
+        config_args=[
+            "x86-hello64-static",
+            "--num-cores",
+            "2",
+            "--resource-directory",
+            resource_path,
+        ]
+        + extra_args,
+        valid_isas=(constants.all_compiled_tag,),
+        length=constants.quick_tag,
+        protocol="CHI",
+    )
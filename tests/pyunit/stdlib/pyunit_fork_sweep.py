@@ -0,0 +1,138 @@
+import csv
+import json
+import os
+import tempfile
+import unittest
+from unittest.mock import patch
+
+import m5
+
+from gem5.simulate.sweep import ForkSweep
+
+
+class FakeChildren:
+    """
+    Stands in for m5.fork and os.wait. Each "child" writes the result a
+    real child would, or nothing if its point fails, and is reaped in the
+    order it was forked.
+    """
+
+    def __init__(self, outdir, failing=()):
+        self.outdir = outdir
+        self.failing = failing
+        self.next_pid = 100
+        self.running = []
+        self.max_running = 0
+
+    def fork(self, outdir):
+        index = int(os.path.basename(outdir)[len("sweep") :])
+        child_outdir = os.path.join(self.outdir, f"sweep{index}")
+        os.makedirs(child_outdir)
+        if index not in self.failing:
+            with open(os.path.join(child_outdir, "sweep.json"), "w") as f:
+                json.dump({"index": index, "sim_ticks": 10 * index}, f)
+
+        pid = self.next_pid
+        self.next_pid += 1
+        self.running.append((pid, index))
+        self.max_running = max(self.max_running, len(self.running))
+        return pid
+
+    def wait(self):
+        pid, index = self.running.pop(0)
+        # Like a child that called sys.exit(1) or sys.exit(0)
+        return pid, (1 if index in self.failing else 0) << 8
+
+
+class ForkSweepTestSuite(unittest.TestCase):
+    """Tests gem5.simulate.sweep.ForkSweep with fake child processes."""
+
+    def setUp(self) -> None:
+        self.outdir = tempfile.TemporaryDirectory()
+        self.addCleanup(self.outdir.cleanup)
+
+    def run_sweep(self, children, points, **kwargs):
+        sweep = ForkSweep(
+            simulator=None,
+            points=points,
+            apply=lambda point: None,
+            stats=["simSeconds"],
+            **kwargs,
+        )
+        with patch.object(m5, "fork", children.fork), patch.object(
+            m5, "listenersDisabled", lambda: True
+        ), patch.object(m5.options, "outdir", self.outdir.name), patch(
+            "os.wait", children.wait
+        ):
+            return sweep, sweep.run()
+
+    def test_grid(self) -> None:
+        self.assertEqual(
+            [
+                {"a": 1, "b": "x"},
+                {"a": 1, "b": "y"},
+                {"a": 2, "b": "x"},
+                {"a": 2, "b": "y"},
+            ],
+            ForkSweep.grid(a=[1, 2], b=["x", "y"]),
+        )
+        self.assertEqual([{}], ForkSweep.grid())
+
+    def test_rows_in_point_order(self) -> None:
+        children = FakeChildren(self.outdir.name)
+        _, table = self.run_sweep(children, ForkSweep.grid(a=[0, 1, 2]))
+        self.assertEqual(
+            [{"index": i, "sim_ticks": 10 * i} for i in range(3)], table
+        )
+
+    def test_failed_child(self) -> None:
+        children = FakeChildren(self.outdir.name, failing=(1,))
+        points = ForkSweep.grid(a=[0, 1, 2])
+        with patch("gem5.simulate.sweep.warn") as warn:
+            _, table = self.run_sweep(children, points)
+        warn.assert_called_once()
+
+        # The failed point keeps its parameters, the results are None
+        self.assertEqual(
+            {"a": 1, "sim_ticks": None, "simSeconds": None}, table[1]
+        )
+        # and the other points are not affected
+        self.assertEqual({"index": 2, "sim_ticks": 20}, table[2])
+
+    def test_parallel_limit(self) -> None:
+        children = FakeChildren(self.outdir.name)
+        _, table = self.run_sweep(
+            children, ForkSweep.grid(a=range(7)), max_parallel=3
+        )
+        self.assertEqual(3, children.max_running)
+        self.assertEqual(7, len(table))
+        self.assertFalse(children.running)
+
+    def test_requires_disabled_listeners(self) -> None:
+        sweep = ForkSweep(None, [{}], lambda point: None, [])
+        with patch.object(m5, "listenersDisabled", lambda: False):
+            with self.assertRaises(RuntimeError):
+                sweep.run()
+
+    def test_write_csv(self) -> None:
+        children = FakeChildren(self.outdir.name, failing=(0,))
+        sweep, _ = self.run_sweep(children, ForkSweep.grid(a=[0, 1]))
+
+        # run() writes the table to the output directory
+        with open(os.path.join(self.outdir.name, "sweep.csv")) as f:
+            rows = list(csv.DictReader(f))
+        self.assertEqual(
+            [
+                {"a": "0", "sim_ticks": "", "simSeconds": "", "index": ""},
+                {"a": "", "sim_ticks": "10", "simSeconds": "", "index": "1"},
+            ],
+            rows,
+        )
+
+        path = os.path.join(self.outdir.name, "copy.csv")
+        sweep.write_csv(path)
+        with open(path) as f:
+            self.assertEqual(
+                ["a", "sim_ticks", "simSeconds", "index"],
+                next(csv.reader(f)),
+            )
@@ -62,6 +62,7 @@
 #include "base/str.hh"
 #include "base/trace.hh"
 #include "cpu/base.hh"
+#include "sim/cxx_config_bin.hh"
 #include "sim/cxx_config_ini.hh"
 #include "sim/cxx_manager.hh"
 #include "sim/init_signals.hh"
@@ -78,8 +79,13 @@ void
 usage(const std::string &prog_name)
 {
     std::cerr << "Usage: " << prog_name << (
-        " <config-file.ini> [ <option> ]\n\n"
+        " <config-file> [ <option> ]\n\n"
+        "The config file is either a .ini or a binary config file made\n"
+        "with -w.\n\n"
         "OPTIONS:\n"
+        "    -w <file>                    -- write the .ini config file as"
+        " a binary\n"
+        "                                    config file and exit\n"
         "    -p <object> <param> <value>  -- set a parameter\n"
         "    -v <object> <param> <values> -- set a vector parameter from"
         " a comma\n"
@@ -123,7 +129,19 @@ main(int argc, char **argv)
 
     const std::string config_file(argv[arg_ptr]);
 
-    CxxConfigFileBase *conf = new CxxIniFile();
+    if (argc > arg_ptr + 2 && std::string(argv[arg_ptr + 1]) == "-w") {
+        if (!CxxBinaryConfigFile::convert(config_file, argv[arg_ptr + 2])) {
+            std::cerr << "Can't convert config file: " << config_file << '\n';
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    CxxConfigFileBase *conf;
+    if (CxxBinaryConfigFile::isBinaryConfig(config_file))
+        conf = new CxxBinaryConfigFile();
+    else
+        conf = new CxxIniFile();
 
     if (!conf->load(config_file.c_str())) {
         std::cerr << "Can't open config file: " << config_file << '\n';
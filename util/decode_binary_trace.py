@@ -0,0 +1,403 @@
+#!/usr/bin/env python3
+
+# Decodes the binary debug traces written with --debug-binary into the text
+# gem5 would have printed. See src/base/binary_trace.hh for the format.
+#
+# Usage: decode_binary_trace.py [--flags] [--no-ticks] <trace> [<output>]
+
+import argparse
+import gzip
+import struct
+import sys
+
+MAX_TICK = 2**64 - 1
+
+
+class Spec:
+    """A conversion of a cprintf format, see base/cprintf.cc"""
+
+    def __init__(self):
+        self.alternate = False
+        self.left = False
+        self.sign = False
+        self.zero = False
+        self.upper = False
+        self.base = 10
+        self.kind = None
+        self.float_kind = "g"
+        self.precision = -1
+        self.width = 0
+        self.get_width = False
+        self.get_precision = False
+
+
+def parse_spec(fmt, pos):
+    """Parses the conversion starting at the '%' at pos, like
+    Print::processFlag does. Returns the spec and the position after it."""
+    spec = Spec()
+    end_number = False
+    have_precision = False
+    number = 0
+    while True:
+        pos += 1
+        c = fmt[pos] if pos < len(fmt) else "\0"
+        if "0" <= c <= "9":
+            if end_number:
+                continue
+        elif number > 0:
+            end_number = True
+
+        done = False
+        if c == "s":
+            spec.kind = "s"
+            done = True
+        elif c == "c":
+            spec.kind = "c"
+            done = True
+        elif c == "l":
+            continue
+        elif c == "p":
+            spec.kind = "i"
+            spec.base = 16
+            spec.alternate = True
+            done = True
+        elif c in "xX":
+            spec.upper = c == "X"
+            spec.base = 16
+            spec.kind = "i"
+            done = True
+        elif c == "o":
+            spec.base = 8
+            spec.kind = "i"
+            done = True
+        elif c in "diu":
+            spec.kind = "i"
+            done = True
+        elif c in "gGeEf":
+            spec.upper = c in "GE"
+            spec.kind = "f"
+            spec.float_kind = c.lower()
+            done = True
+        elif c == "#":
+            spec.alternate = True
+        elif c == "-":
+            spec.left = True
+        elif c == "+":
+            spec.sign = True
+        elif c == " ":
+            pass
+        elif c == ".":
+            spec.width = number
+            spec.precision = 0
+            have_precision = True
+            number = 0
+            end_number = False
+        elif c == "0" and number == 0:
+            spec.zero = True
+        elif "0" <= c <= "9":
+            number = number * 10 + int(c)
+        elif c == "*":
+            if have_precision:
+                spec.get_precision = True
+            else:
+                spec.get_width = True
+        else:
+            done = True
+
+        if end_number:
+            if have_precision:
+                spec.precision = number
+            else:
+                spec.width = number
+            end_number = False
+            number = 0
+
+        if done:
+            if spec.kind == "i" and have_precision:
+                spec.width = spec.precision
+                spec.zero = True
+            elif spec.kind == "f" and not have_precision and spec.zero:
+                spec.precision = spec.width
+            return spec, pos + 1
+
+
+def pad(text, spec, fill=" "):
+    if len(text) >= spec.width:
+        return text
+    if spec.left and fill == " ":
+        return text + fill * (spec.width - len(text))
+    return fill * (spec.width - len(text)) + text
+
+
+def as_string(tag, value):
+    """What operator<< prints for a value"""
+    if tag == "c":
+        return chr(value)
+    if tag == "b":
+        return str(int(value))
+    if tag == "p":
+        return hex(value) if value else "0"
+    if tag == "f":
+        return "%g" % value
+    return str(value)
+
+
+def format_integer(tag, value, spec, size=8):
+    if tag == "s":
+        try:
+            value = int(value, 0)
+        except ValueError:
+            return pad(value, spec)
+    elif tag == "f":
+        return pad("%g" % value, spec)
+    elif tag == "b":
+        return pad(str(int(value)), spec)
+
+    if value < 0 and spec.base != 10:
+        # Printed as the unsigned value of the same size
+        value &= (1 << (8 * size)) - 1
+    digits = {10: "%d", 16: "%x", 8: "%o"}[spec.base] % abs(value)
+    if spec.upper:
+        digits = digits.upper()
+    sign = "-" if value < 0 else ("+" if spec.sign else "")
+
+    prefix = ""
+    if spec.alternate and (value != 0 or spec.zero):
+        prefix = {10: "", 16: "0X" if spec.upper else "0x", 8: "0"}[
+            spec.base
+        ]
+    if spec.zero:
+        # The prefix is printed before the zero padding
+        width = spec.width - len(prefix)
+        body = sign + digits
+        return prefix + "0" * max(0, width - len(body)) + body
+    return pad(sign + prefix + digits, spec)
+
+
+def format_float(tag, value, spec):
+    if tag == "s":
+        try:
+            value = float(value)
+        except ValueError:
+            return pad(value, spec)
+    elif tag == "c":
+        value = float(value)
+    fmt = "%"
+    precision = spec.precision
+    kind = spec.float_kind
+    if kind == "e" and precision == 0:
+        precision, kind = 1, "g"
+    if precision == -1:
+        kind = "g"
+    elif kind == "e" or kind == "f" or kind == "g":
+        fmt += ".%d" % precision
+    fmt += kind.upper() if spec.upper else kind
+    return pad(fmt % value, spec, "0" if spec.zero else " ")
+
+
+def format_arg(tag, value, spec):
+    size = 8
+    if tag == "i":
+        size, value = value
+    if spec.kind == "s":
+        return pad(as_string(tag, value), spec)
+    if spec.kind == "c":
+        if tag in "iuc":
+            return chr(value & 0xFF)
+        return as_string(tag, value)
+    if spec.kind == "i":
+        return format_integer(tag, value, spec, size)
+    if spec.kind == "f":
+        return format_float(tag, value, spec)
+    return "<bad format>"
+
+
+def literal(text):
+    # cprintf turns lone carriage returns into newlines
+    return text.replace("\r\n", "\n").replace("\r", "\n")
+
+
+def number(tag, value):
+    """Width or precision taken from an argument, which must be an int"""
+    if tag == "i" and value[0] == 4:
+        return value[1]
+    return 0
+
+
+def cformat(fmt, args):
+    """Formats a message like ccprintf does, quirks included"""
+    out = []
+    pos = 0
+
+    def next_spec():
+        # Print::process, copies the text up to the next conversion
+        nonlocal pos
+        while pos < len(fmt):
+            pct = fmt.find("%", pos)
+            if pct < 0:
+                break
+            out.append(literal(fmt[pos:pct]))
+            if fmt[pct + 1 : pct + 2] == "%":
+                out.append("%")
+                pos = pct + 2
+                continue
+            spec, pos = parse_spec(fmt, pct)
+            return spec
+        out.append(literal(fmt[pos:]))
+        pos = len(fmt)
+        return Spec()
+
+    spec = None
+    cont = False
+    for tag, value in args:
+        if not cont:
+            spec = next_spec()
+        if spec.get_width:
+            spec.get_width = False
+            cont = True
+            spec.width = number(tag, value)
+            continue
+        if spec.get_precision:
+            spec.get_precision = False
+            cont = True
+            spec.precision = number(tag, value)
+            continue
+        out.append(format_arg(tag, value, spec))
+
+    # Print::endArgs
+    while pos < len(fmt):
+        pct = fmt.find("%", pos)
+        if pct < 0:
+            out.append(literal(fmt[pos:]))
+            break
+        out.append(literal(fmt[pos:pct]))
+        if fmt[pct + 1 : pct + 2] != "%":
+            out.append("<extra arg>")
+        out.append("%")
+        pos = pct + 2
+    return "".join(out)
+
+
+ARG_FORMATS = {"b": "<B", "c": "<B", "u": "<Q", "p": "<Q", "f": "<d"}
+
+
+def unpack_args(data):
+    args = []
+    pos = 0
+    while pos < len(data):
+        tag = chr(data[pos])
+        pos += 1
+        if tag == "s":
+            (length,) = struct.unpack_from("<I", data, pos)
+            pos += 4
+            value = data[pos : pos + length].decode(errors="replace")
+            pos += length
+        elif tag == "i":
+            value = struct.unpack_from("<Bq", data, pos)
+            pos += 9
+        else:
+            fmt = ARG_FORMATS[tag]
+            (value,) = struct.unpack_from(fmt, data, pos)
+            pos += struct.calcsize(fmt)
+        args.append((tag, value))
+    return args
+
+
+class Decoder:
+    def __init__(self, out, flags, ticks):
+        self.out = out
+        self.flags = flags
+        self.ticks = ticks
+        # String tables, per thread
+        self.strings = {}
+
+    def line(self, tick, name, flag, message):
+        prefix = ""
+        if self.ticks and tick != MAX_TICK:
+            prefix += "%7d: " % tick
+        if self.flags and flag:
+            prefix += flag + ": "
+        if name:
+            prefix += name + ": "
+        self.out.write(prefix + message)
+
+    def chunk(self, thread, data):
+        strings = self.strings.setdefault(thread, {})
+        pos = 0
+        while pos < len(data):
+            kind = chr(data[pos])
+            pos += 1
+            if kind == "D":
+                sid, length = struct.unpack_from("<II", data, pos)
+                pos += 8
+                strings[sid] = data[pos : pos + length].decode(
+                    errors="replace"
+                )
+                pos += length
+            elif kind == "M":
+                tick, name, flag, fmt, length = struct.unpack_from(
+                    "<QIIII", data, pos
+                )
+                pos += 24
+                args = unpack_args(data[pos : pos + length])
+                pos += length
+                self.line(
+                    tick,
+                    strings[name],
+                    strings[flag],
+                    cformat(strings[fmt], args),
+                )
+            elif kind == "T":
+                tick, name, flag, length = struct.unpack_from(
+                    "<QIII", data, pos
+                )
+                pos += 20
+                message = data[pos : pos + length].decode(errors="replace")
+                pos += length
+                self.line(tick, strings[name], strings[flag], message)
+            else:
+                sys.exit(f"Corrupt trace: unknown record '{kind}'")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decodes a binary gem5 debug trace into text."
+    )
+    parser.add_argument("trace", help="binary trace, optionally gzipped")
+    parser.add_argument(
+        "output", nargs="?", help="text output, stdout by default"
+    )
+    parser.add_argument(
+        "--flags",
+        action="store_true",
+        help="print the flag of every message, like the FmtFlag flag",
+    )
+    parser.add_argument(
+        "--no-ticks",
+        action="store_true",
+        help="do not print ticks, like the FmtTicksOff flag",
+    )
+    args = parser.parse_args()
+
+    with open(args.trace, "rb") as f:
+        gzipped = f.read(2) == b"\x1f\x8b"
+    trace = (gzip.open if gzipped else open)(args.trace, "rb")
+    out = open(args.output, "w") if args.output else sys.stdout
+
+    if trace.read(8) != b"gem5btrc":
+        sys.exit(f"{args.trace} is not a binary gem5 trace")
+    (version,) = struct.unpack("<I", trace.read(4))
+    if version != 1:
+        sys.exit(f"Unsupported trace version {version}")
+
+    decoder = Decoder(out, args.flags, not args.no_ticks)
+    while True:
+        header = trace.read(8)
+        if len(header) < 8:
+            break
+        thread, length = struct.unpack("<II", header)
+        decoder.chunk(thread, trace.read(length))
+
+
+if __name__ == "__main__":
+    main()
@@ -318,15 +318,15 @@ start_func "switch" $SW_HOST "$ENV_ARGS" $GEM5_EXE -d $RUN_DIR/m5out.switch   \
 SW_PID=$!
 
 # block here till switch process starts
-connected $RUN_DIR/log.switch "tcp_iface listening on port" "switch" $SW_PID
+connected $RUN_DIR/log.switch "_iface listening on port" "switch" $SW_PID
 
 # actual port that switch is listening on may be different
 # from what we specified if the port was busy
-PORT_REGEX="tcp_iface listening on port ([0-9]+)"
+PORT_REGEX="(tcp|shm)_iface listening on port ([0-9]+)"
 SW_FILE=$(cat $RUN_DIR/log.switch)
 
 if [[ $SW_FILE =~ $PORT_REGEX ]]; then
-    SW_PORT="${BASH_REMATCH[1]}"
+    SW_PORT="${BASH_REMATCH[2]}"
 else
     echo "Unable to find port info from $RUN_DIR/log.switch"
     abort_func